@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Builds bench/hermes_compat.cpp from the working tree against the Hermes headers of each revision and runs it, so
+# per-publish numbers can be compared across commits on one machine.
+#   bench/compare_revisions.sh [revision...]
+# With no revisions, compares the tree before the Hermes series (454d6b7), the last commit before the dense type index
+# (d64abc1), the commit adding it (de9b111) and HEAD. CXX and CXXFLAGS override the compiler and flags.
+set -euo pipefail
+
+root="$(git -C "$(dirname "$0")" rev-parse --show-toplevel)"
+cxx="${CXX:-g++}"
+read -r -a flags <<< "${CXXFLAGS:--O2 -DNDEBUG}"
+
+revisions=("$@")
+if [ ${#revisions[@]} -eq 0 ]; then
+    revisions=(454d6b7 d64abc1 de9b111 HEAD)
+fi
+
+work="$(mktemp -d)"
+trap 'rm -rf "$work"' EXIT
+
+for revision in "${revisions[@]}"; do
+    dir="$work/$(git -C "$root" rev-parse --short "$revision")"
+    mkdir -p "$dir"
+    git -C "$root" archive "$revision" include | tar -x -C "$dir"
+    "$cxx" -std=c++23 "${flags[@]}" -I"$dir/include" "$root/bench/hermes_compat.cpp" -o "$dir/bench" -pthread
+
+    echo "== $revision ($(git -C "$root" log -1 --format=%s "$revision"))"
+    "$dir/bench"
+done
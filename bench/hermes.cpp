@@ -0,0 +1,358 @@
+// Hermes microbenchmarks. Writes JSON to stdout, or to the file given with --out, so runs can be diffed across commits.
+//   theia_bench_hermes [--out <file>] [--filter <substring>]
+
+#include "theia/hermes.hpp"
+#include "theia/overlay.hpp"
+#include "theia/static_hermes.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+struct Small {
+    MAKE_HERMES_ID(theia::bench::Small);
+    std::uint64_t value;
+};
+
+template <std::size_t N>
+struct Blob {
+    std::array<std::byte, N> data;
+};
+
+// Each size needs its own ID, so every blob is a distinct type
+struct Blob64 : Blob<64> {
+    MAKE_HERMES_ID(theia::bench::Blob64);
+};
+
+struct Blob1024 : Blob<1024> {
+    MAKE_HERMES_ID(theia::bench::Blob1024);
+};
+
+struct Blob4096 : Blob<4096> {
+    MAKE_HERMES_ID(theia::bench::Blob4096);
+};
+
+struct Keyed {
+    MAKE_HERMES_ID(theia::bench::Keyed);
+    HERMES_KEY(key);
+    std::uint64_t key;
+};
+
+struct Posted {
+    MAKE_HERMES_ID(theia::bench::Posted);
+    std::uint64_t value;
+};
+
+// Receivers write here so the optimizer cannot drop the dispatch
+volatile std::uint64_t sink = 0;
+
+struct Result {
+    std::string name;
+    std::size_t ops;
+    double median_ns;
+    double min_ns;
+};
+
+constexpr std::size_t REPETITIONS = 15;
+
+class Bench {
+public:
+    explicit Bench(std::optional<std::string> filter)
+        : filter_(std::move(filter)) {}
+
+    // Runs `f` (which performs `ops` operations) a few times and records the median and best time per operation
+    template <typename Func>
+    void run(const std::string &name, std::size_t ops, Func &&f) {
+        if (filter_ && name.find(*filter_) == std::string::npos) return;
+
+        f(); // Warm-up
+
+        std::array<double, REPETITIONS> samples{};
+        for (auto &sample : samples) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+            sample = elapsed.count() / static_cast<double>(ops);
+        }
+
+        std::ranges::sort(samples);
+        results_.push_back(Result{name, ops, samples[REPETITIONS / 2], samples.front()});
+        fmt::print(stderr, "{:<40} {:>10.2f} ns/op\n", name, samples[REPETITIONS / 2]);
+    }
+
+    [[nodiscard]] std::string json() const {
+        std::string out = "{\n";
+        out += "  \"benchmark\": \"hermes\",\n";
+#if defined(THEIA_HERMES_STATS)
+        out += "  \"hermes_stats\": true,\n";
+#else
+        out += "  \"hermes_stats\": false,\n";
+#endif
+        out += fmt::format("  \"repetitions\": {},\n", REPETITIONS);
+        out += "  \"results\": [\n";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const auto &r = results_[i];
+            out += fmt::format(R"(    {{"name": "{}", "ops": {}, )", r.name, r.ops);
+            out += fmt::format(R"("median_ns_per_op": {:.3f}, "min_ns_per_op": {:.3f}}})", r.median_ns, r.min_ns);
+            out += i + 1 < results_.size() ? ",\n" : "\n";
+        }
+        out += "  ]\n}\n";
+        return out;
+    }
+
+private:
+    std::optional<std::string> filter_;
+    std::vector<Result> results_{};
+};
+
+constexpr std::size_t OPS = 100'000;
+
+void bench_fanout(Bench &bench) {
+    for (const std::size_t subscribers : {0, 1, 10, 1000}) {
+        theia::Hermes hermes;
+        hermes.set_delivery<Small>(theia::Delivery::Immediate); // Creates the channel, so 0 measures an empty dispatch
+
+        std::vector<theia::Subscription> subscriptions;
+        for (std::size_t i = 0; i < subscribers; ++i)
+            subscriptions.push_back(hermes.subscribe<Small>([](Small *e) { sink = sink + e->value; }));
+
+        bench.run(fmt::format("publish/subscribers:{}", subscribers), OPS, [&] {
+            for (std::size_t i = 0; i < OPS; ++i)
+                hermes.publish<Small>(i);
+        });
+    }
+}
+
+// Same receivers as bench_fanout, on a bus whose event set is fixed at compile time
+void bench_static(Bench &bench) {
+    for (const std::size_t subscribers : {0, 1, 10, 1000}) {
+        theia::StaticHermes<Small, Posted> hermes;
+        for (std::size_t i = 0; i < subscribers; ++i)
+            hermes.subscribe<Small>([](Small *e) { sink = sink + e->value; });
+
+        bench.run(fmt::format("static/publish/subscribers:{}", subscribers), OPS, [&] {
+            for (std::size_t i = 0; i < OPS; ++i)
+                hermes.publish<Small>(i);
+        });
+    }
+}
+
+// The same handlers subscribed at runtime versus fixed in the bus type through with(). They add to a plain counter
+// rather than `sink`, whose volatile accesses would cost more than the calls being compared; only the fixed ones are
+// direct calls the compiler can inline and combine.
+template <std::size_t... I>
+void bench_static_inline(Bench &bench, std::index_sequence<I...>) {
+    std::uint64_t total = 0;
+    const auto handler = [&total](Small *e) { total += e->value; };
+
+    {
+        theia::StaticHermes<Small, Posted> hermes;
+        (((void)I, (void)hermes.subscribe<Small>(handler)), ...);
+
+        bench.run(fmt::format("static/delegate/subscribers:{}", sizeof...(I)), OPS, [&] {
+            for (std::size_t i = 0; i < OPS; ++i)
+                hermes.publish<Small>(i);
+        });
+    }
+
+    {
+        auto hermes = theia::StaticHermes<Small, Posted>::with(((void)I, handler)...);
+        bench.run(fmt::format("static/inline/subscribers:{}", sizeof...(I)), OPS, [&] {
+            for (std::size_t i = 0; i < OPS; ++i)
+                hermes.template publish<Small>(i);
+        });
+    }
+
+    sink = total;
+}
+
+void bench_no_channel(Bench &bench) {
+    theia::Hermes hermes;
+    bench.run("publish/no_channel", OPS, [&] {
+        for (std::size_t i = 0; i < OPS; ++i)
+            hermes.publish<Small>(i);
+    });
+}
+
+template <typename T>
+void bench_payload(Bench &bench, std::string_view label) {
+    theia::Hermes hermes;
+    auto subscription = hermes.subscribe<T>([](T *) { sink = sink + 1; });
+    bench.run(fmt::format("publish/payload:{}", label), OPS, [&] {
+        for (std::size_t i = 0; i < OPS; ++i)
+            hermes.publish<T>();
+    });
+}
+
+void bench_capture(Bench &bench) {
+    theia::Hermes hermes;
+    std::vector<theia::Subscription> subscriptions;
+    for (std::size_t i = 0; i < 1000; ++i)
+        subscriptions.push_back(hermes.subscribe<Small>([](Small *e) { sink = sink + e->value; }));
+    hermes.capture<Small>(subscriptions[500].id());
+
+    bench.run("publish/capture:1_of_1000", OPS, [&] {
+        for (std::size_t i = 0; i < OPS; ++i)
+            hermes.publish<Small>(i);
+    });
+}
+
+// 100 receivers that each want one key, registered through the index versus filtering inside the handler
+void bench_keyed(Bench &bench) {
+    constexpr std::uint64_t KEYS = 100;
+
+    {
+        theia::Hermes hermes;
+        std::vector<theia::Subscription> subscriptions;
+        for (std::uint64_t key = 0; key < KEYS; ++key)
+            subscriptions.push_back(hermes.subscribe_keyed<Keyed>(key, [](Keyed *e) { sink = sink + e->key; }));
+
+        bench.run(fmt::format("publish/keyed:{}_keys", KEYS), OPS, [&] {
+            for (std::size_t i = 0; i < OPS; ++i)
+                hermes.publish<Keyed>(i % KEYS);
+        });
+    }
+
+    {
+        theia::Hermes hermes;
+        std::vector<theia::Subscription> subscriptions;
+        for (std::uint64_t key = 0; key < KEYS; ++key)
+            subscriptions.push_back(hermes.subscribe<Keyed>([key](Keyed *e) {
+                if (e->key == key) sink = sink + e->key;
+            }));
+
+        bench.run(fmt::format("publish/filtered:{}_keys", KEYS), OPS, [&] {
+            for (std::size_t i = 0; i < OPS; ++i)
+                hermes.publish<Keyed>(i % KEYS);
+        });
+    }
+}
+
+void bench_deferred(Bench &bench) {
+    theia::Hermes hermes;
+    hermes.set_delivery<Small>(theia::Delivery::Deferred);
+    auto subscription = hermes.subscribe<Small>([](Small *e) { sink = sink + e->value; });
+
+    bench.run("deferred/publish_and_drain", OPS, [&] {
+        for (std::size_t i = 0; i < OPS; ++i)
+            hermes.publish<Small>(i);
+        hermes.drain();
+    });
+}
+
+void bench_churn(Bench &bench) {
+    constexpr std::size_t CHURN_OPS = 10'000;
+
+    {
+        theia::Hermes hermes;
+        std::vector<theia::Subscription> others;
+        for (std::size_t i = 0; i < 100; ++i)
+            others.push_back(hermes.subscribe<Small>([](Small *) {}));
+
+        const auto id = hermes.acquire_id();
+        bench.run("churn/subscribe_unsubscribe", CHURN_OPS, [&] {
+            for (std::size_t i = 0; i < CHURN_OPS; ++i) {
+                hermes.subscribe<Small>(id, [](Small *) {});
+                hermes.unsubscribe<Small>(id);
+            }
+        });
+    }
+
+    {
+        theia::Hermes hermes;
+        bench.run("churn/subscription_handle", CHURN_OPS, [&] {
+            for (std::size_t i = 0; i < CHURN_OPS; ++i)
+                auto subscription = hermes.subscribe<Small>([](Small *) {});
+        });
+    }
+
+    {
+        theia::Hermes hermes;
+        bench.run("churn/group_of_4", CHURN_OPS, [&] {
+            for (std::size_t i = 0; i < CHURN_OPS; ++i) {
+                theia::SubscriptionGroup group(hermes);
+                group.subscribe<Small>([](Small *) {});
+                group.subscribe<Posted>([](Posted *) {});
+                group.subscribe<theia::OverlayTabEvent>([](theia::OverlayTabEvent *) {});
+                group.subscribe<Blob64>([](Blob64 *) {});
+            }
+        });
+    }
+}
+
+void bench_mailbox(Bench &bench) {
+    constexpr std::size_t MAILBOX_OPS = 1 << 18;
+
+    for (const std::size_t producers : {1, 4, 16}) {
+        theia::Hermes hermes;
+        std::uint64_t received = 0;
+        auto subscription = hermes.subscribe<Posted>([&](Posted *) { ++received; });
+        auto &mailbox = hermes.mailbox<Posted>(1 << 14);
+
+        bench.run(fmt::format("mailbox/producers:{}", producers), MAILBOX_OPS, [&] {
+            received = 0;
+            std::atomic<bool> go{false};
+            std::vector<std::jthread> threads;
+            for (std::size_t p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    while (!go.load(std::memory_order_acquire)) {}
+                    for (std::size_t i = p; i < MAILBOX_OPS; i += producers)
+                        while (!mailbox.try_emplace(i)) std::this_thread::yield();
+                });
+            }
+
+            go.store(true, std::memory_order_release);
+            while (received < MAILBOX_OPS)
+                hermes.drain();
+        });
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::optional<std::string> out_path{};
+    std::optional<std::string> filter{};
+    for (int i = 1; i < argc; ++i) {
+        const auto arg = std::string_view(argv[i]);
+        if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        }
+    }
+
+    Bench bench(filter);
+    bench_no_channel(bench);
+    bench_fanout(bench);
+    bench_static(bench);
+    bench_static_inline(bench, std::make_index_sequence<1>());
+    bench_static_inline(bench, std::make_index_sequence<10>());
+    bench_payload<theia::OverlayTabEvent>(bench, "0");
+    bench_payload<Small>(bench, "8");
+    bench_payload<Blob64>(bench, "64");
+    bench_payload<Blob1024>(bench, "1024");
+    bench_payload<Blob4096>(bench, "4096");
+    bench_capture(bench);
+    bench_keyed(bench);
+    bench_deferred(bench);
+    bench_churn(bench);
+    bench_mailbox(bench);
+
+    if (out_path) {
+        std::ofstream(*out_path) << bench.json();
+    } else {
+        fmt::print("{}", bench.json());
+    }
+}
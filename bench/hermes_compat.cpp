@@ -0,0 +1,131 @@
+// Per-publish cost using only the API every revision of Hermes has had: acquire_id(), subscribe<T>(id, f) and
+// publish<T>(...). bench/compare_revisions.sh builds this file against the headers of older commits, so it must not
+// use anything newer (nor fmt, which those trees may not have had).
+//   theia_bench_hermes_compat
+
+#include "theia/hermes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <tuple>
+#include <utility>
+
+namespace {
+#define COMPAT_EVENT(n)                                                                                                \
+    struct Event##n {                                                                                                  \
+        MAKE_HERMES_ID(theia::bench::compat::Event##n);                                                                \
+        std::uint64_t value;                                                                                           \
+    };
+
+COMPAT_EVENT(0)
+COMPAT_EVENT(1)
+COMPAT_EVENT(2)
+COMPAT_EVENT(3)
+COMPAT_EVENT(4)
+COMPAT_EVENT(5)
+COMPAT_EVENT(6)
+COMPAT_EVENT(7)
+COMPAT_EVENT(8)
+COMPAT_EVENT(9)
+COMPAT_EVENT(10)
+COMPAT_EVENT(11)
+COMPAT_EVENT(12)
+COMPAT_EVENT(13)
+COMPAT_EVENT(14)
+COMPAT_EVENT(15)
+COMPAT_EVENT(16)
+COMPAT_EVENT(17)
+COMPAT_EVENT(18)
+COMPAT_EVENT(19)
+COMPAT_EVENT(20)
+COMPAT_EVENT(21)
+COMPAT_EVENT(22)
+COMPAT_EVENT(23)
+COMPAT_EVENT(24)
+COMPAT_EVENT(25)
+COMPAT_EVENT(26)
+COMPAT_EVENT(27)
+COMPAT_EVENT(28)
+COMPAT_EVENT(29)
+COMPAT_EVENT(30)
+COMPAT_EVENT(31)
+
+struct Unheard {
+    MAKE_HERMES_ID(theia::bench::compat::Unheard);
+    std::uint64_t value;
+};
+
+#undef COMPAT_EVENT
+
+// Receivers write here so the optimizer cannot drop the dispatch
+volatile std::uint64_t sink = 0;
+
+constexpr std::size_t PUBLISHES = 5'000'000;
+constexpr std::size_t REPETITIONS = 9;
+
+// Median time per publish over REPETITIONS runs of `f`, which publishes PUBLISHES times
+template <typename Func>
+double median_ns(Func &&f) {
+    f(); // Warm-up
+
+    std::array<double, REPETITIONS> samples{};
+    for (auto &sample : samples) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        sample = elapsed.count() / static_cast<double>(PUBLISHES);
+    }
+    std::ranges::sort(samples);
+    return samples[REPETITIONS / 2];
+}
+
+template <typename T>
+void subscribe_one(theia::Hermes &hermes) {
+    hermes.subscribe<T>(hermes.acquire_id(), [](T *e) { sink = sink + e->value; });
+}
+
+template <std::size_t... I>
+double publish_round_robin(std::index_sequence<I...>) {
+    using Events = std::tuple<Event0,  Event1,  Event2,  Event3,  Event4,  Event5,  Event6,  Event7,
+                              Event8,  Event9,  Event10, Event11, Event12, Event13, Event14, Event15,
+                              Event16, Event17, Event18, Event19, Event20, Event21, Event22, Event23,
+                              Event24, Event25, Event26, Event27, Event28, Event29, Event30, Event31>;
+
+    theia::Hermes hermes;
+    (subscribe_one<std::tuple_element_t<I, Events>>(hermes), ...);
+    return median_ns([&] {
+        for (std::size_t i = 0; i < PUBLISHES; i += sizeof...(I))
+            (hermes.publish<std::tuple_element_t<I, Events>>(i), ...);
+    });
+}
+} // namespace
+
+int main() {
+    const auto one = [] {
+        theia::Hermes hermes;
+        subscribe_one<Event0>(hermes);
+        return median_ns([&] {
+            for (std::size_t i = 0; i < PUBLISHES; ++i)
+                hermes.publish<Event0>(i);
+        });
+    }();
+
+    const auto many = publish_round_robin(std::make_index_sequence<32>());
+
+    const auto unheard = [] {
+        theia::Hermes hermes;
+        subscribe_one<Event0>(hermes);
+        return median_ns([&] {
+            for (std::size_t i = 0; i < PUBLISHES; ++i)
+                hermes.publish<Unheard>(i);
+        });
+    }();
+
+    std::printf("%-32s %8.1f ns/publish\n", "1 type, 1 receiver", one);
+    std::printf("%-32s %8.1f ns/publish\n", "32 types, 1 receiver each", many);
+    std::printf("%-32s %8.1f ns/publish\n", "type nobody subscribed to", unheard);
+}
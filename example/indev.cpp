@@ -1,9 +1,45 @@
 #include "theia/theia.hpp"
 #include <glad/gl.h>
 
-int main(int, char *[]) {
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+int main(int argc, char *argv[]) {
     using theia::Dear;
 
+    // --record <trace> captures the input of this session, --replay <trace> [--max-speed] plays one back headlessly,
+    // --shm <name> mirrors input events for theia_hermes_inspect; all three are only available on POSIX systems
+    std::optional<std::filesystem::path> record_path{};
+    std::optional<std::filesystem::path> replay_path{};
+    bool max_speed = false;
+#if defined(THEIA_HAS_SHM_SINK)
+    std::optional<std::string> shm_name{};
+#endif
+    for (int i = 1; i < argc; ++i) {
+        const auto arg = std::string_view(argv[i]);
+        if (arg == "--record" && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (arg == "--max-speed") {
+            max_speed = true;
+#if defined(THEIA_HAS_SHM_SINK)
+        } else if (arg == "--shm" && i + 1 < argc) {
+            shm_name = argv[++i];
+#endif
+        }
+    }
+#if !defined(THEIA_HAS_TRACE)
+    if (record_path || replay_path) {
+        THEIA_LOG_WARN("Traces are not supported on this platform; ignoring --record and --replay");
+        record_path.reset();
+        replay_path.reset();
+    }
+#endif
+
     const auto glfw = glfwpp::Context();
 
     const auto window = glfwpp::WindowBuilder()
@@ -11,12 +47,49 @@ int main(int, char *[]) {
                             .opengl_profile(glfwpp::OpenGLProfile::Core)
                             .title("Indev")
                             .size(glm::ivec2{800, 600})
+                            .visible(!replay_path)
                             .wayland_app_id("theia")
                             .build();
     window->set_icon("assets/gem_16x16.png");
 
-    const auto hermes_id = theia::Hermes::instance().acquire_id();
-    theia::Hermes::instance().subscribe<theia::OverlayTabEvent>(hermes_id, [&](const auto *) {
+    struct {
+        glm::vec2 cursor{0.0f};
+        glm::vec2 scroll{0.0f};
+        int last_key{-1};
+        int last_button{-1};
+        std::size_t events{0};
+    } input;
+
+    theia::SubscriptionGroup subscriptions{};
+    subscriptions.subscribe<glfwpp::event::KeyEvent>([&](const auto *e) {
+        input.last_key = e->key;
+    });
+    subscriptions.subscribe<glfwpp::event::CursorPosEvent>([&](const auto *e) {
+        input.cursor = {static_cast<float>(e->xpos), static_cast<float>(e->ypos)};
+    });
+    subscriptions.subscribe<glfwpp::event::MouseButtonEvent>([&](const auto *e) {
+        input.last_button = e->button;
+    });
+    subscriptions.subscribe<glfwpp::event::ScrollEvent>([&](const auto *e) {
+        input.scroll.x += static_cast<float>(e->xoffset);
+        input.scroll.y += static_cast<float>(e->yoffset);
+    });
+    subscriptions.subscribe_category(glfwpp::event::category::Input, [&](theia::EventView) { ++input.events; });
+
+    // Stats every dropped file on the shared worker pool, so a large drop doesn't stall glfwPollEvents()
+    subscriptions.subscribe_async<glfwpp::event::DropEvent>([](const glfwpp::event::DropEvent &e) {
+        for (const auto &path : e.paths) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(path, ec);
+            if (ec) {
+                THEIA_LOG_WARN("Dropped '{}': {}", path.string(), ec.message());
+            } else {
+                THEIA_LOG_INFO("Dropped '{}' ({} bytes)", path.string(), size);
+            }
+        }
+    });
+
+    subscriptions.subscribe<theia::OverlayTabEvent>([&](const auto *) {
         Dear::TabItem("Window") && [&] {
             static bool vsync = true;
             if (ImGui::Checkbox("vsync", &vsync)) {
@@ -74,12 +147,57 @@ int main(int, char *[]) {
                 window->set_opacity(opacity);
             }
         };
+
+        Dear::TabItem("Input") && [&] {
+            Dear::Text("cursor: {:.1f}, {:.1f}", input.cursor.x, input.cursor.y);
+            Dear::Text("scroll: {:.1f}, {:.1f}", input.scroll.x, input.scroll.y);
+            Dear::Text("last key: {}", input.last_key);
+            Dear::Text("last button: {}", input.last_button);
+            Dear::Text("events: {}", input.events);
+        };
     });
 
     const auto dear = Dear::Context(*window);
 
+#if defined(THEIA_HAS_TRACE)
+    std::optional<theia::TraceRecorder> recorder{};
+    if (record_path) {
+        recorder.emplace(*record_path);
+        recorder->watch<glfwpp::event::KeyEvent>();
+        recorder->watch<glfwpp::event::CharEvent>();
+        recorder->watch<glfwpp::event::CursorPosEvent>();
+        recorder->watch<glfwpp::event::CursorEnterEvent>();
+        recorder->watch<glfwpp::event::MouseButtonEvent>();
+        recorder->watch<glfwpp::event::ScrollEvent>();
+    }
+#endif
+
+#if defined(THEIA_HAS_SHM_SINK)
+    std::optional<theia::ShmSink> sink{};
+    if (shm_name) {
+        sink.emplace(*shm_name);
+        sink->watch<glfwpp::event::KeyEvent>();
+        sink->watch<glfwpp::event::CursorPosEvent>();
+        sink->watch<glfwpp::event::MouseButtonEvent>();
+        sink->watch<glfwpp::event::ScrollEvent>();
+    }
+#endif
+
+#if defined(THEIA_HAS_TRACE)
+    std::optional<theia::TraceReplay> replay{};
+    if (replay_path) {
+        replay.emplace(*replay_path, max_speed ? theia::ReplaySpeed::Maximum : theia::ReplaySpeed::Original);
+    }
+#endif
+    const auto replay_start = std::chrono::steady_clock::now();
+    std::size_t frames = 0;
+
     while (!window->should_close()) {
         glfwPollEvents();
+#if defined(THEIA_HAS_TRACE)
+        if (replay && !replay->pump()) window->set_should_close(true);
+#endif
+        theia::Hermes::instance().drain();
 
         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
         glClear(GL_COLOR_BUFFER_BIT);
@@ -89,5 +207,11 @@ int main(int, char *[]) {
         Dear::Render();
 
         window->swap_buffers();
+        ++frames;
+    }
+
+    if (replay_path) {
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - replay_start);
+        THEIA_LOG_INFO("Replayed {} events over {} frames in {:.2f} ms", input.events, frames, elapsed.count());
     }
 }
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// HERMES_CATEGORY bits of the glfwpp events. glfwpp owns bits 0-7; the rest are free for application event types.
+namespace glfwpp::event::category {
+constexpr std::uint32_t Input = 1 << 0;
+constexpr std::uint32_t Keyboard = 1 << 1;
+constexpr std::uint32_t Mouse = 1 << 2;
+constexpr std::uint32_t Window = 1 << 3;
+constexpr std::uint32_t Monitor = 1 << 4;
+constexpr std::uint32_t Joystick = 1 << 5;
+} // namespace glfwpp::event::category
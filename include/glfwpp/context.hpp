@@ -1,9 +1,12 @@
 #pragma once
 
+#include "theia/hermes.hpp"
+
 namespace glfwpp {
 class Context {
 public:
-    Context();
+    // Monitor events are published on `hermes`
+    explicit Context(theia::Hermes &hermes = theia::Hermes::instance());
     ~Context();
 
     Context(const Context &other) = delete;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "glfwpp/category.hpp"
 #include "glfwpp/context.hpp"
 #include "glfwpp/input.hpp"
 #include "glfwpp/monitor.hpp"
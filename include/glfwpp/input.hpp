@@ -1,5 +1,6 @@
 #pragma once
 
+#include "glfwpp/category.hpp"
 #include "glfwpp/window.hpp"
 
 #include "theia/hermes.hpp"
@@ -7,13 +8,18 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <filesystem>
 #include <string>
+#include <vector>
 
 namespace glfwpp {
 namespace event {
 struct KeyEvent {
     MAKE_HERMES_ID(glfwpp::event::KeyEvent);
-    Window window;
+    HERMES_CATEGORY(category::Input | category::Keyboard);
+    HERMES_SOURCE(window.handle());
+    HERMES_KEY(key);
+    WindowRef window;
     int key;
     int scancode;
     int action;
@@ -22,26 +28,36 @@ struct KeyEvent {
 
 struct CharEvent {
     MAKE_HERMES_ID(glfwpp::event::CharEvent);
-    Window window;
+    HERMES_CATEGORY(category::Input | category::Keyboard);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     unsigned int codepoint;
 };
 
 struct CursorPosEvent {
     MAKE_HERMES_ID(glfwpp::event::CursorPosEvent);
-    Window window;
+    HERMES_CATEGORY(category::Input | category::Mouse);
+    HERMES_COALESCE(LatestWins);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     double xpos;
     double ypos;
 };
 
 struct CursorEnterEvent {
     MAKE_HERMES_ID(glfwpp::event::CursorEnterEvent);
-    Window window;
+    HERMES_CATEGORY(category::Input | category::Mouse);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     bool entered;
 };
 
 struct MouseButtonEvent {
     MAKE_HERMES_ID(glfwpp::event::MouseButtonEvent);
-    Window window;
+    HERMES_CATEGORY(category::Input | category::Mouse);
+    HERMES_SOURCE(window.handle());
+    HERMES_KEY(button);
+    WindowRef window;
     int button;
     int action;
     int mods;
@@ -49,16 +65,25 @@ struct MouseButtonEvent {
 
 struct ScrollEvent {
     MAKE_HERMES_ID(glfwpp::event::ScrollEvent);
-    Window window;
+    HERMES_CATEGORY(category::Input | category::Mouse);
+    HERMES_COALESCE(Accumulate);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     double xoffset;
     double yoffset;
+
+    void accumulate(const ScrollEvent &next) {
+        xoffset += next.xoffset;
+        yoffset += next.yoffset;
+    }
 };
 
 struct DropEvent {
     MAKE_HERMES_ID(glfwpp::event::DropEvent);
-    Window window;
-    int count;
-    const char **paths;
+    HERMES_CATEGORY(category::Input);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
+    std::vector<std::filesystem::path> paths; // Owned, so receivers may hold on to the payload past the callback
 };
 } // namespace event
 
@@ -77,6 +102,7 @@ enum class JoystickEventType {
 
 struct JoystickEvent {
     MAKE_HERMES_ID(glfwpp::event::JoystickEvent);
+    HERMES_CATEGORY(category::Input | category::Joystick);
     int jid;
     JoystickEventType event;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "glfwpp/category.hpp"
 #include "theia/hermes.hpp"
 
 #define GLFW_INCLUDE_NONE
@@ -57,12 +58,17 @@ enum class MonitorEventType {
     Disconnected = GLFW_DISCONNECTED,
 };
 
+// Sticky per monitor: every connected monitor is primed as Connected, and a monitor's entry is forgotten once it is
+// disconnected, so late subscribers are replayed exactly the monitors that are still there
 struct MonitorEvent {
     MAKE_HERMES_ID(glfwpp::event::MonitorEvent);
+    HERMES_CATEGORY(category::Monitor);
+    HERMES_STICKY;
+    HERMES_SOURCE(monitor.handle());
     Monitor monitor;
     MonitorEventType event;
 };
 } // namespace event
 
-void set_monitor_callbacks();
+void set_monitor_callbacks(theia::Hermes &hermes);
 } // namespace glfwpp
\ No newline at end of file
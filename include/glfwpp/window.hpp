@@ -1,5 +1,6 @@
 #pragma once
 
+#include "glfwpp/category.hpp"
 #include "glfwpp/cursor.hpp"
 #include "glfwpp/monitor.hpp"
 #include "theia/hermes.hpp"
@@ -30,9 +31,31 @@ enum class CursorMode {
     Captured = GLFW_CURSOR_CAPTURED,
 };
 
+class Window;
+
+// Non-owning handle for event payloads; resolves to the owning Window through the GLFW user pointer.
+class WindowRef {
+public:
+    WindowRef() = default;
+    WindowRef(GLFWwindow *handle);
+
+    [[nodiscard]] Window *get() const;
+    Window &operator*() const;
+    Window *operator->() const;
+
+    explicit operator bool() const;
+    bool operator==(const WindowRef &other) const = default;
+
+    [[nodiscard]] GLFWwindow *handle() const;
+
+private:
+    GLFWwindow *handle_ = nullptr;
+};
+
 class Window {
 public:
-    explicit Window(GLFWwindow *window);
+    // Events from this window are published on `hermes`
+    explicit Window(GLFWwindow *window, theia::Hermes &hermes = theia::Hermes::instance());
     ~Window();
 
     Window(const Window &) = delete;
@@ -48,6 +71,9 @@ public:
 
     void swap_buffers();
 
+    // Sizes, content scale, position, focus, iconification and maximization are cached from the window callbacks, so
+    // their getters are plain loads; a change made through a setter shows up once GLFW reports it, usually on the next
+    // poll. The other attributes are still queried from GLFW on every call.
     [[nodiscard]] glm::ivec2 size() const;
     void set_size(glm::ivec2 size);
     [[nodiscard]] int w() const;
@@ -131,10 +157,28 @@ public:
     [[nodiscard]] void *user_pointer() const;
     void set_user_pointer(void *ptr);
 
+    [[nodiscard]] theia::Hermes &hermes() const;
+
     [[nodiscard]] GLFWwindow *handle() const;
+    [[nodiscard]] WindowRef ref() const;
 
 private:
+    friend void set_window_callbacks(Window &window);
+
+    struct State_ {
+        glm::ivec2 size{};
+        glm::ivec2 framebuffer_size{};
+        glm::vec2 content_scale{1.0f};
+        glm::ivec2 position{};
+        bool focused = false;
+        bool iconified = false;
+        bool maximized = false;
+    };
+
     GLFWwindow *handle_ = nullptr;
+    void *user_pointer_ = nullptr;
+    theia::Hermes *hermes_ = nullptr;
+    State_ state_{};
 };
 
 enum class ClientApi {
@@ -227,6 +271,9 @@ public:
     // Wayland specific hints
     WindowBuilder &wayland_app_id(const std::string &app_id);
 
+    // Bus the window publishes its events to; defaults to theia::Hermes::instance()
+    WindowBuilder &hermes(theia::Hermes &hermes);
+
     [[nodiscard]] std::unique_ptr<Window> build() const;
 
 private:
@@ -235,6 +282,7 @@ private:
     std::string title_ = "Theia Application";
     GLFWmonitor *monitor_ = nullptr;
     GLFWwindow *share_ = nullptr;
+    theia::Hermes *hermes_ = nullptr;
 
     std::unordered_map<int, int> hints_;
     std::unordered_map<int, std::string> str_hints_;
@@ -243,58 +291,82 @@ private:
 namespace event {
 struct WindowCloseEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowCloseEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
 };
 
 struct WindowSizeEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowSizeEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_COALESCE(LatestWins);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     int width;
     int height;
 };
 
 struct FramebufferSizeEvent {
     MAKE_HERMES_ID(glfwpp::event::FramebufferSizeEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_STICKY;
+    HERMES_COALESCE(LatestWins);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     int width;
     int height;
 };
 
 struct WindowContentScaleEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowContentScaleEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_STICKY;
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     float xscale;
     float yscale;
 };
 
 struct WindowPosEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowPosEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_COALESCE(LatestWins);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     int xpos;
     int ypos;
 };
 
 struct WindowIconifyEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowIconifyEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     bool iconified;
 };
 
 struct WindowMaximizeEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowMaximizeEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     bool maximized;
 };
 
 struct WindowFocusEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowFocusEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_STICKY;
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
     bool focused;
 };
 
 struct WindowRefreshEvent {
     MAKE_HERMES_ID(glfwpp::event::WindowRefreshEvent);
-    Window window;
+    HERMES_CATEGORY(category::Window);
+    HERMES_SOURCE(window.handle());
+    WindowRef window;
 };
 } // namespace event
 
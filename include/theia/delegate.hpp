@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace theia {
+template <typename Signature, std::size_t Capacity = 6 * sizeof(void *)>
+class Delegate;
+
+// Move-only callable that always stores its target inline; anything that does not fit is a compile error rather than
+// a heap allocation.
+template <typename R, typename... Args, std::size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+    Delegate() = default;
+
+    template <typename Func>
+        requires(!std::same_as<std::remove_cvref_t<Func>, Delegate> and std::is_invocable_v<Func &, Args...>)
+    Delegate(Func &&f);
+
+    ~Delegate();
+
+    Delegate(const Delegate &other) = delete;
+    Delegate &operator=(const Delegate &other) = delete;
+
+    Delegate(Delegate &&other) noexcept;
+    Delegate &operator=(Delegate &&other) noexcept;
+
+    R operator()(Args... args);
+
+    explicit operator bool() const;
+
+private:
+    using Invoke = R (*)(void *, Args...);
+
+    // Move-constructs the target from `src` into `dst` and destroys `src`; with a null `dst` it only destroys `src`.
+    // Left null for trivially copyable targets, which are relocated with a memcpy instead.
+    using Relocate = void (*)(void *dst, void *src);
+
+    alignas(std::max_align_t) std::byte storage_[Capacity];
+    Invoke invoke_{nullptr};
+    Relocate relocate_{nullptr};
+
+    void reset_();
+    void steal_(Delegate &other);
+};
+} // namespace theia
+
+template <typename R, typename... Args, std::size_t Capacity>
+template <typename Func>
+    requires(!std::same_as<std::remove_cvref_t<Func>, theia::Delegate<R(Args...), Capacity>> and
+             std::is_invocable_v<Func &, Args...>)
+theia::Delegate<R(Args...), Capacity>::Delegate(Func &&f) {
+    using F = std::decay_t<Func>;
+    static_assert(sizeof(F) <= Capacity, "Delegate target does not fit in the inline buffer");
+    static_assert(alignof(F) <= alignof(std::max_align_t), "Delegate target is over-aligned");
+    static_assert(std::is_nothrow_move_constructible_v<F>, "Delegate target must be nothrow move constructible");
+
+    ::new (static_cast<void *>(storage_)) F(std::forward<Func>(f));
+
+    invoke_ = [](void *target, Args... args) -> R {
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(*static_cast<F *>(target), std::forward<Args>(args)...);
+        } else {
+            return std::invoke(*static_cast<F *>(target), std::forward<Args>(args)...);
+        }
+    };
+
+    if constexpr (!std::is_trivially_copyable_v<F>) {
+        relocate_ = [](void *dst, void *src) {
+            if (dst) ::new (dst) F(std::move(*static_cast<F *>(src)));
+            static_cast<F *>(src)->~F();
+        };
+    }
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+theia::Delegate<R(Args...), Capacity>::~Delegate() {
+    reset_();
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+theia::Delegate<R(Args...), Capacity>::Delegate(Delegate &&other) noexcept {
+    steal_(other);
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+theia::Delegate<R(Args...), Capacity> &theia::Delegate<R(Args...), Capacity>::operator=(Delegate &&other) noexcept {
+    if (this != &other) {
+        reset_();
+        steal_(other);
+    }
+    return *this;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+R theia::Delegate<R(Args...), Capacity>::operator()(Args... args) {
+    return invoke_(storage_, std::forward<Args>(args)...);
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+theia::Delegate<R(Args...), Capacity>::operator bool() const {
+    return invoke_ != nullptr;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+void theia::Delegate<R(Args...), Capacity>::reset_() {
+    if (invoke_ && relocate_) relocate_(nullptr, storage_);
+    invoke_ = nullptr;
+    relocate_ = nullptr;
+}
+
+template <typename R, typename... Args, std::size_t Capacity>
+void theia::Delegate<R(Args...), Capacity>::steal_(Delegate &other) {
+    if (!other.invoke_) return;
+
+    if (other.relocate_) {
+        other.relocate_(storage_, other.storage_);
+    } else {
+        std::memcpy(storage_, other.storage_, Capacity);
+    }
+    invoke_ = std::exchange(other.invoke_, nullptr);
+    relocate_ = std::exchange(other.relocate_, nullptr);
+}
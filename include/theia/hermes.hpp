@@ -1,11 +1,34 @@
 #pragma once
 
+#include "theia/delegate.hpp"
+#include "theia/mpsc_queue.hpp"
+#include "theia/worker_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <ranges>
 #include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace murmur {
@@ -22,20 +45,233 @@ constexpr std::uint32_t x86_32(const char (&s)[N], const std::uint32_t seed) {
 }
 } // namespace murmur
 
-#define MAKE_HERMES_ID(name) constexpr static std::uint32_t HERMES_ID{murmur::x86_32(#name, 0)};
+// Also registers the type with Hermes before main() runs; see theia::internal::HermesRegistration
+#define MAKE_HERMES_ID(name)                                                                                           \
+    constexpr static std::uint32_t HERMES_ID{murmur::x86_32(#name, 0)};                                               \
+    constexpr static std::string_view HERMES_NAME{#name};                                                             \
+    auto hermes_registration() const -> theia::internal::HermesRegistered<std::remove_cvref_t<decltype(*this)>>;
+
+// How queued payloads of a deferred type are merged before drain(); see theia::Coalesce
+#define HERMES_COALESCE(policy) constexpr static theia::Coalesce HERMES_COALESCE_POLICY{theia::Coalesce::policy};
+
+// Identifies what raised an event (e.g. a window), so per-source state is kept apart
+#define HERMES_SOURCE(expr)                                                                                            \
+    const void *hermes_source() const { return expr; }
+
+// Field that Hermes::subscribe_keyed() indexes receivers on (e.g. which key a KeyEvent is for)
+#define HERMES_KEY(field)                                                                                              \
+    auto hermes_key() const { return field; }
+
+// The event describes state: the latest payload per source is kept, handed to receivers as they subscribe and readable
+// through Hermes::latest()
+#define HERMES_STICKY constexpr static bool HERMES_IS_STICKY{true};
+
+// Bitmask of the categories the event belongs to, for Hermes::subscribe_category()
+#define HERMES_CATEGORY(bits) constexpr static std::uint32_t HERMES_CATEGORY_BITS{bits};
 
 namespace theia {
 template <typename T>
 concept HashHermesId = std::same_as<decltype(T::HERMES_ID), const std::uint32_t>;
 
+template <typename T>
+concept HasHermesSource = requires(const T &t) {
+    { t.hermes_source() } -> std::convertible_to<const void *>;
+};
+
+template <typename T>
+concept HasHermesKey = requires(const T &t) {
+    { std::hash<decltype(t.hermes_key())>{}(t.hermes_key()) } -> std::convertible_to<std::size_t>;
+    { t.hermes_key() == t.hermes_key() } -> std::convertible_to<bool>;
+};
+
+template <typename T>
+concept IsHermesSticky = requires { requires T::HERMES_IS_STICKY; };
+
+template <HasHermesKey T>
+using HermesKey = decltype(std::declval<const T &>().hermes_key());
+
+// Build-time guard for a known set of event types, e.g. static_assert(unique_hermes_ids<A, B, C>())
+template <typename... Ts>
+    requires(HashHermesId<Ts> and ...)
+consteval bool unique_hermes_ids() {
+    const std::array<std::uint32_t, sizeof...(Ts)> ids{Ts::HERMES_ID...};
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        for (std::size_t j = i + 1; j < ids.size(); ++j)
+            if (ids[i] == ids[j]) return false;
+    return true;
+}
+
+class Hermes;
+class Subscription;
+
+namespace internal {
+// Registers T with Hermes (see Hermes::event_types()) during static initialization. MAKE_HERMES_ID names
+// HermesRegistered<T> in a member declaration, which is enough to instantiate `index`, so every event type linked into
+// the program is registered, and checked for ID collisions, before main() runs.
+template <typename T>
+struct HermesRegistration {
+    static const std::size_t index;
+};
+
+template <typename T>
+using HermesRegistered = std::integral_constant<const std::size_t *, &HermesRegistration<T>::index>;
+} // namespace internal
+
+struct EventInfo {
+    std::size_t index; // Dense, process-wide; stable for the lifetime of the process
+    std::uint32_t id;
+    std::string_view name;
+    std::size_t size;
+    std::size_t alignment;
+    std::uint32_t category; // HERMES_CATEGORY bits, 0 if none
+
+    // Re-publishes a payload from its raw bytes; only set for trivially copyable types
+    void (*republish)(Hermes &hermes, std::span<const std::byte> bytes);
+};
+
+#if defined(THEIA_HERMES_STATS)
+struct HandlerStats {
+    // Bucket i counts calls that took less than 2^i microseconds; the last bucket also takes everything slower
+    static constexpr std::size_t BUCKETS = 16;
+
+    std::uint64_t calls{0};
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::array<std::uint64_t, BUCKETS> histogram{};
+
+    void record(std::chrono::nanoseconds elapsed);
+};
+
+struct EventStats {
+    std::size_t index; // EventInfo::index
+    std::uint64_t published;
+    std::vector<std::pair<std::size_t, HandlerStats>> handlers; // Keyed by subscriber ID
+};
+#endif
+
+// Type-tagged payload handed to category listeners; only valid for the duration of the call
+struct EventView {
+    std::uint32_t id; // HERMES_ID of the payload's type
+    void *payload;
+
+    template <typename T>
+        requires HashHermesId<T>
+    [[nodiscard]] bool is() const;
+
+    // Null unless the payload is a T
+    template <typename T>
+        requires HashHermesId<T>
+    [[nodiscard]] T *as() const;
+};
+
+// Tracks the async receivers (see Hermes::subscribe_async) one publish() handed to worker pools. Empty if there were
+// none, which includes deferred types: their async receivers are started by drain() and nothing waits on them.
+class Completion {
+public:
+    Completion() = default;
+
+    // True once every tracked receiver has returned
+    [[nodiscard]] bool done() const;
+    void wait() const;
+
+private:
+    friend class Hermes;
+
+    std::shared_ptr<std::atomic<std::size_t>> remaining_{};
+
+    explicit Completion(std::size_t count);
+};
+
+enum class Coalesce {
+    None,       // Every payload is delivered
+    LatestWins, // Only the most recent payload per source is delivered
+    Accumulate, // Payloads per source are folded into one with `void accumulate(const T &next)`
+};
+
+enum class Delivery {
+    Immediate, // Receivers run inside publish()
+    Deferred,  // publish() queues the payload, receivers run on the next drain()
+};
+
 class Hermes {
-    using Payload = std::span<std::byte>;
-    using Receiver = std::function<void(Payload)>;
+    template <typename T>
+    using Receiver = Delegate<void(T *)>;
+
+    template <typename T>
+    using BatchReceiver = Delegate<void(std::span<const T>)>;
+
+    template <typename T>
+    using AsyncReceiver = Delegate<void(const T &)>;
+
+    // Key type of the per-channel index; a placeholder for types without HERMES_KEY
+    template <typename T>
+    struct Key_ {
+        using type = std::nullptr_t;
+    };
+
+    template <HasHermesKey T>
+    struct Key_<T> {
+        using type = HermesKey<T>;
+    };
+
+    using CategoryReceiver = Delegate<void(EventView)>;
+
+    struct AcceptAll_ {
+        bool operator()(const auto &) const { return true; }
+    };
+
+    // Intrusive list node for a coroutine suspended in next<T>(); lives in the coroutine frame, so waiting never
+    // allocates
+    template <typename T>
+    struct Waiter_ {
+        Waiter_ *next{nullptr};
+        Waiter_ **prev_next{nullptr}; // Null while not linked into any list
+        bool (*accepts)(Waiter_ *self, const T &payload){nullptr};
+        std::coroutine_handle<> handle{};
+        T *payload{nullptr};
+
+        void link(Waiter_ *&head);
+        void unlink();
+    };
 
 public:
     using ID = std::size_t;
 
+    template <typename T, typename Pred>
+    class NextAwaiter;
+
+    Hermes() = default;
+    ~Hermes();
+
+    Hermes(const Hermes &other) = delete;
+    Hermes &operator=(const Hermes &other) = delete;
+
+    Hermes(Hermes &&other) = delete;
+    Hermes &operator=(Hermes &&other) = delete;
+
+    // A Hermes belongs to the first thread that publishes to or drains it, which is where publishing, draining, taps,
+    // delivery and mailbox setup happen. Subscribing, unsubscribing, capturing and acquiring or releasing IDs are safe
+    // from any thread and from inside receivers: dispatch walks a snapshot of the subscriber lists and never waits for
+    // a lock (see publish() for the one exception), so a change takes effect from the next payload (receivers removed
+    // meanwhile are skipped right away). Adding or removing a regular receiver takes amortized constant time; other
+    // changes copy the lists of the channels they touch (see ChannelBase_). Sticky payloads are replayed on the
+    // subscribing thread once the lists are unlocked. Subscribing from another thread therefore runs the new receiver
+    // there, at the same time as the owning thread may be dispatching to it, and a payload published meanwhile can
+    // reach it before an older one being replayed; subscribe on the owning thread to keep the receiver on it and in
+    // order.
+    // instance() is the process-wide default that glfwpp and the overlay publish to unless given another bus;
+    // thread_instance() is a separate bus per calling thread, for subsystems that run their own loop.
     static Hermes &instance();
+    static Hermes &thread_instance();
+
+    // Every event type linked into this process, ordered by EventInfo::index. Types that define HERMES_ID without
+    // MAKE_HERMES_ID are only registered once they are first used.
+    static std::vector<EventInfo> event_types();
+    static std::optional<EventInfo> find_event_type(std::uint32_t id);
+
+    // Sees the bytes of every trivially copyable payload as it is published, whether or not anything receives it
+    using Tap = Delegate<void(std::uint32_t id, std::span<const std::byte> payload)>;
+    using TapID = std::size_t;
 
     ID acquire_id();
     void release_id(ID id);
@@ -44,13 +280,71 @@ public:
         requires HashHermesId<T> and std::invocable<Func, T *>
     void subscribe(ID id, Func &&f);
 
+    // Subscribes under a fresh ID owned by the returned handle; dropping the handle unsubscribes
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::invocable<Func, T *>
+    [[nodiscard]] Subscription subscribe(Func &&f);
+
+    // Only payloads whose hermes_source() is `source` reach this receiver (e.g. a single window's input), and dispatch
+    // never visits receivers scoped to other sources. Subscribing an ID again moves it to the new scope.
+    template <typename T, typename Func>
+        requires HashHermesId<T> and HasHermesSource<T> and std::invocable<Func, T *>
+    void subscribe(ID id, const void *source, Func &&f);
+
+    // Only payloads whose hermes_key() equals `key` reach this receiver. Keyed receivers are found through a hash index
+    // on the key, so dispatch calls them plus the unkeyed receivers and skips everyone registered for other keys.
+    // Subscribing an ID again moves it to the new key.
+    template <typename T, typename Func>
+        requires HashHermesId<T> and HasHermesKey<T> and std::invocable<Func, T *>
+    void subscribe_keyed(ID id, HermesKey<T> key, Func &&f);
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and HasHermesKey<T> and std::invocable<Func, T *>
+    [[nodiscard]] Subscription subscribe_keyed(HermesKey<T> key, Func &&f);
+
+    // `f` receives every T published since the previous drain() in one contiguous span, in publish order and before any
+    // coalescing. An ID can hold a batch receiver and a regular one for the same type; unsubscribe() drops both.
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::copy_constructible<T> and std::invocable<Func, std::span<const T>>
+    void subscribe_batch(ID id, Func &&f);
+
+    // `f` runs on `pool` after the regular receivers, so a slow handler doesn't hold up the publishing thread. It sees
+    // a shared copy of the payload that lives until every async receiver is done with it, may run concurrently with
+    // itself and with the owning thread, and must not publish to this Hermes (post back through a mailbox instead).
+    // Subject to capture like any receiver; unsubscribe() drops it as well.
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::move_constructible<T> and std::invocable<Func, const T &>
+    void subscribe_async(ID id, Func &&f, WorkerPool &pool = WorkerPool::instance());
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::move_constructible<T> and std::invocable<Func, const T &>
+    [[nodiscard]] Subscription subscribe_async(Func &&f, WorkerPool &pool = WorkerPool::instance());
+
     template <typename T>
         requires HashHermesId<T>
     void unsubscribe(ID id);
 
+    // `f` sees every payload whose type's HERMES_CATEGORY shares a bit with `mask`, after that type's own receivers and
+    // subject to its capture. Listeners are linked into the matching channels up front, so dispatch walks one list per
+    // type and types no listener wants pay nothing. An ID holds one listener; subscribing it again replaces it.
+    template <typename Func>
+        requires std::invocable<Func, EventView>
+    void subscribe_category(ID id, std::uint32_t mask, Func &&f);
+
+    template <typename Func>
+        requires std::invocable<Func, EventView>
+    [[nodiscard]] Subscription subscribe_category(std::uint32_t mask, Func &&f);
+
+    void unsubscribe_category(ID id);
+
+    // The returned Completion tracks the async receivers started by this call. Publishing takes no lock, except the
+    // first time a sticky type, or a category type while category listeners exist, is published before anything
+    // subscribed to it: creating its channel links it into the channel table and category listeners under mutex_, so
+    // that one call waits for any mutator holding it. Subscribing to the type or setting its delivery beforehand
+    // creates the channel up front.
     template <typename T, typename... Args>
         requires HashHermesId<T>
-    void publish(Args &&...args);
+    Completion publish(Args &&...args);
 
     template <typename T>
         requires HashHermesId<T>
@@ -60,15 +354,513 @@ public:
         requires HashHermesId<T>
     void uncapture(ID id, bool force = false);
 
+    // Payloads of deferred types are moved into the queue, so they must not point at anything that only lives for the
+    // duration of the publishing call. Types declaring HERMES_COALESCE are merged while queued,
+    // so each source delivers at most one payload per drain.
+    template <typename T>
+        requires HashHermesId<T> and std::move_constructible<T>
+    void set_delivery(Delivery delivery);
+
+    // Cross-thread entry point for T. Call on the thread that owns this Hermes, then hand the queue to producers: they
+    // post with try_emplace() from any thread and the payloads are published by the next drain() on the owning thread.
+    // `capacity` only applies to the first call for a given type.
+    template <typename T>
+        requires HashHermesId<T> and std::move_constructible<T>
+    MpscQueue<T> &mailbox(std::size_t capacity = 1024);
+
+    // Publishes everything posted to mailboxes, then delivers everything queued for deferred types and flushes batch
+    // receivers, one type at a time. Events published while draining are held for the next call.
+    void drain();
+
+    // Safe from inside a tap or receiver: a tap added meanwhile sees the next payload, and one removed is not called
+    // again, even for the payload being tapped
+    TapID add_tap(Tap tap);
+    void remove_tap(TapID id);
+
+    // Latest payload of a sticky type, from any source or from `source`, or null if there is none; polling costs a
+    // couple of loads. For a deferred type that is the latest one drain() has delivered. Only for the owning thread;
+    // the pointer is only valid until the next T is published.
+    template <typename T>
+        requires HashHermesId<T> and IsHermesSticky<T>
+    const T *latest();
+
+    template <typename T>
+        requires HashHermesId<T> and IsHermesSticky<T> and HasHermesSource<T>
+    const T *latest(const void *source);
+
+    // Drops the sticky payloads raised by `source`, e.g. once a window is destroyed. Only for the owning thread, as it
+    // invalidates what latest() returned there.
+    void forget(const void *source);
+
+    // co_await hermes.next<T>(pred) suspends the coroutine until the next T for which `pred` holds is dispatched, and
+    // resumes it from inside that dispatch (so during drain() for deferred types). Waiters are subject to capture like
+    // any receiver. The returned payload pointer is only valid until the coroutine suspends again.
+    template <typename T, typename Pred = AcceptAll_>
+        requires HashHermesId<T> and std::predicate<Pred &, const T &>
+    NextAwaiter<T, Pred> next(Pred pred = {});
+
+#if defined(THEIA_HERMES_STATS)
+    // Publish counts per type and call timings per plain receiver; batch, async and category receivers aren't timed.
+    // Only for the owning thread, as it updates both without a lock while dispatching.
+    [[nodiscard]] std::vector<EventStats> stats() const;
+    void reset_stats();
+#endif
+
 private:
+    template <typename T>
+    friend struct internal::HermesRegistration;
+
+    struct CategoryListener_ {
+        ID id;
+        std::uint32_t mask;
+        CategoryReceiver receiver;
+        std::atomic<bool> live{true};
+    };
+
+    // Receivers live in their channel's Arena_, so one keeps its address while it runs even if the lists it is in are
+    // rebuilt. `live` is cleared as it is removed, so a dispatch still walking a snapshot that lists it skips it.
+    template <typename T>
+    struct Node_ {
+        Receiver<T> receiver{};
+        const void *source{nullptr}; // Null when unscoped
+        std::optional<typename Key_<T>::type> key{};
+        std::atomic<bool> live{false};
+        std::atomic<bool> vacant{true}; // Cleared and free to be handed out again
+#if defined(THEIA_HERMES_STATS)
+        HandlerStats stats{};
+#endif
+    };
+
+    // Hands out a channel's nodes from chunks that never move, in subscription order, so dispatch walks neighbouring
+    // memory rather than one heap allocation per receiver. A released node is only handed out again once the quiescent
+    // point after its release has cleared it.
+    template <typename T>
+    struct Arena_ {
+        static constexpr std::size_t FIRST_CHUNK = 8;
+        static constexpr std::size_t LAST_CHUNK = 1024;
+
+        std::vector<std::unique_ptr<Node_<T>[]>> chunks{};
+        std::size_t chunk_size{0};
+        std::size_t used{0};               // Nodes handed out from the last chunk
+        std::deque<Node_<T> *> released{}; // Oldest first, so the front is the first to be cleared
+
+        Node_<T> &acquire();
+        void release(Hermes &hermes, Node_<T> &node);
+    };
+
+    template <typename R>
+    struct Held_ {
+        R receiver;
+        std::atomic<bool> live{true};
+    };
+
+    // The fields here are the authoritative subscriber lists. They are only touched under mutex_, and dispatch reads a
+    // snapshot of them published by rebuild(), which copies every list; the snapshot it replaces is retired rather than
+    // freed (see DispatchGuard_). Regular receivers don't need one: a new one is appended to the snapshot in place
+    // while its list has room, and a removed one stays listed but dead until the dead outnumber the living, so
+    // subscribing and unsubscribing take amortized constant time. `slots` maps an ID to its position in `ids`, so
+    // removal is a swap with the last entry. Batch, async and category receivers and the capture are rare enough to
+    // rebuild on every change, in time linear in the channel's receivers. Changes spanning several channels mark them
+    // stale and rebuild each once.
+    struct ChannelBase_ {
+        static constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+        std::optional<ID> capture{};
+        std::vector<ID> ids{};
+        std::vector<std::size_t> slots{};
+        std::vector<ID> batch_ids{};
+        std::vector<ID> async_ids{};
+
+        std::uint32_t category{0};
+        std::vector<CategoryListener_ *> category_listeners{}; // Those whose mask matches `category`
+
+        Delivery delivery{Delivery::Immediate};
+        bool is_pending{false}; // Listed in pending_, i.e. has something for the next drain()
+        bool is_stale{false};   // Listed in stale_, i.e. changed since its snapshot was last rebuilt
+
+#if defined(THEIA_HERMES_STATS)
+        std::uint64_t published{0};
+#endif
+
+        virtual ~ChannelBase_() = default;
+
+        virtual bool erase(Hermes &hermes, ID id) = 0;
+        virtual void rebuild(Hermes &hermes) = 0;
+        virtual void pump(Hermes &hermes) = 0;
+        virtual void stage() = 0;
+        virtual void drain() = 0;
+        virtual void forget(const void *source) = 0;
+#if defined(THEIA_HERMES_STATS)
+        virtual void collect_stats(EventStats &entry) const = 0;
+        virtual void reset_stats() = 0;
+#endif
+        bool holds(ID id) const;
+    };
+
+    template <typename T>
+    struct Channel_ final : ChannelBase_ {
+        using Key = typename Key_<T>::type;
+
+        // A list of receivers that insert() appends to in place while dispatch reads it. `items` is sized to its
+        // capacity when the snapshot is built and never resized; an entry is written before `size` is raised, and
+        // dispatch loads `size` once, so it walks the list as it was at that point.
+        struct Nodes {
+            std::vector<Node_<T> *> items{};
+            std::atomic<std::size_t> size{0};
+
+            void seal();
+            bool append(Node_<T> *node);
+            std::span<Node_<T> *const> entries() const;
+        };
+
+        // What dispatch reads. When T has a source or a key, receivers registered for one are grouped by the key or
+        // else the source, so dispatch walks `receivers` plus the groups of the payload's source and key.
+        struct Snapshot {
+            // Bits of `features`: what the channel has besides plain receivers. publish() only walks `receivers` when
+            // none is set.
+            static constexpr std::uint32_t CAPTURE = 1 << 0;
+            static constexpr std::uint32_t SCOPED = 1 << 1;
+            static constexpr std::uint32_t KEYED = 1 << 2;
+            static constexpr std::uint32_t BATCH = 1 << 3;
+            static constexpr std::uint32_t ASYNC = 1 << 4;
+            static constexpr std::uint32_t CATEGORY = 1 << 5;
+            static constexpr std::uint32_t DEFERRED = 1 << 6;
+
+            std::uint32_t features{0};
+            Nodes receivers{};
+            std::unordered_map<const void *, Nodes> scoped{};
+            std::unordered_map<Key, Nodes> keyed{};
+
+            std::optional<ID> capture{};
+            Node_<T> *captured{nullptr}; // The capturing ID's receiver, if it has one
+
+            std::vector<ID> batch_ids{};
+            std::vector<Held_<BatchReceiver<T>> *> batch_receivers{};
+            std::vector<ID> async_ids{};
+            std::vector<std::shared_ptr<Held_<AsyncReceiver<T>>>> async_receivers{};
+            std::vector<WorkerPool *> async_pools{};
+
+            std::vector<CategoryListener_ *> category_listeners{};
+        };
+
+        std::atomic<const Snapshot *> snapshot{nullptr};
+        Waiter_<T> *waiters{nullptr}; // Next to `snapshot`, as publish() checks both
+        std::unique_ptr<Snapshot> current{}; // Owns `snapshot`
+
+        Arena_<T> arena{};
+        std::vector<Node_<T> *> nodes{};  // Parallel to `ids`
+        std::vector<Node_<T> *> buried{}; // Removed but still listed in `current`; released by the next rebuild()
+
+        // Deferred payloads; swapped with `draining` by stage() so both buffers keep their capacity between frames
+        std::vector<T> queue{};
+        std::vector<T> draining{};
+
+        std::unique_ptr<MpscQueue<T>> mailbox{};
+
+        // Copies of every payload published since the last drain, for batch receivers; double-buffered like `queue`
+        std::vector<std::unique_ptr<Held_<BatchReceiver<T>>>> batch_receivers{}; // Parallel to `batch_ids`
+        std::vector<T> batch{};
+        std::vector<T> flushing{};
+
+        // Shared with the jobs in flight, so a receiver that unsubscribes is only destroyed once it has returned
+        std::vector<std::shared_ptr<Held_<AsyncReceiver<T>>>> async_receivers{}; // Parallel to `async_ids`
+        std::vector<WorkerPool *> async_pools{};
+
+        // Only maintained for sticky types: the latest payload per source, least recently published first. The owning
+        // thread, which publishes and forgets them, only locks sticky_mutex while another thread is replaying them; see
+        // own_sticky() and visit_sticky().
+        std::vector<T> sticky{};
+        std::mutex sticky_mutex{};
+        std::atomic<std::size_t> sticky_visitors{0}; // Other threads in visit_sticky()
+        std::atomic<bool> sticky_owned{false};       // The owning thread is in own_sticky() without the lock
+
+        ~Channel_() override;
+
+        const Snapshot &read() const;
+        Node_<T> &insert(Hermes &hermes, ID id, const void *source, std::optional<Key> key, Receiver<T> &&receiver);
+        void bury(Hermes &hermes, Node_<T> &node);
+        bool erase(Hermes &hermes, ID id) override;
+        void rebuild(Hermes &hermes) override;
+        void enqueue(T &&payload);
+        static bool matches(const Node_<T> &node, const T &payload);
+        void dispatch(T *payload);
+        Completion dispatch_async(T &&payload);
+        static void invoke(Node_<T> &node, T *payload);
+        template <typename F>
+        void own_sticky(F &&f);
+        template <typename F>
+        void visit_sticky(F &&f);
+        template <typename F>
+        void access_sticky(const Hermes &hermes, F &&f);
+        void remember(const T &payload);
+        void replay(Hermes &hermes, ID id, Node_<T> &node);
+        void forget(const void *source) override;
+        void resume_waiters(T *payload);
+        void pump(Hermes &hermes) override;
+        void stage() override;
+        void drain() override;
+#if defined(THEIA_HERMES_STATS)
+        void collect_stats(EventStats &entry) const override;
+        void reset_stats() override;
+#endif
+    };
+
+    // The owning thread reads snapshots without holding mutex_ inside publish() and drain(). Both hold one of these;
+    // the first one binds the owning thread, and leaving the outermost is a quiescent point: nothing can still see what
+    // was retired before it, so that is freed, unless a mutator holds the lock, in which case it is left for the next.
+    struct DispatchGuard_ {
+        Hermes &hermes;
+
+        explicit DispatchGuard_(Hermes &hermes);
+        ~DispatchGuard_();
+    };
+
+    // Held by mutators in place of a plain lock. One running on the owning thread outside of any dispatch is at a
+    // quiescent point itself, so it frees what it retired on the way out rather than leaving it for the next publish.
+    struct MutationGuard_ {
+        Hermes &hermes;
+        std::unique_lock<std::recursive_mutex> lock;
+
+        explicit MutationGuard_(Hermes &hermes);
+        ~MutationGuard_();
+    };
+
+    using ChannelTable_ = std::vector<ChannelBase_ *>;
+
+    // Something dispatch may still be reading, waiting for the next quiescent point to be freed
+    struct Retired_ {
+        const void *garbage;
+        void (*destroy)(const void *garbage);
+    };
+
+    // Guards the subscriber lists, the ID pool and everything below it up to `replaying_`. Recursive because channel_()
+    // takes it both on its own, from publish(), and from mutators that already hold it.
+    mutable std::recursive_mutex mutex_{};
+
     ID next_id_ = 0;
     std::vector<ID> recycled_ids_{};
 
-    std::unordered_map<std::uint32_t, std::optional<ID>> captures_;
-    std::unordered_map<std::uint32_t, std::vector<Receiver>> receivers_;
+    // Indexed by type_index_<T>(), so reaching a type's channel is an array load rather than a hash lookup. publish()
+    // reads `table_`, an immutable copy of the pointers that is replaced whenever a channel is added.
+    std::vector<std::unique_ptr<ChannelBase_>> channels_{};
+    std::atomic<const ChannelTable_ *> table_{nullptr};
+    std::unique_ptr<const ChannelTable_> current_table_{}; // Owns `table_`
+    std::vector<std::vector<std::size_t>> channels_by_id_{};
+    std::vector<bool> category_ids_{}; // Indexed by ID; set while it has a category listener, so others skip the search
 
-    template <typename T, typename... Args>
-    std::span<std::byte> make_payload_(Args &&...args);
+    std::vector<std::unique_ptr<CategoryListener_>> category_listeners_{};
+    std::atomic<std::size_t> category_listener_count_{0}; // Size of `category_listeners_`, for publish() to read
+
+    std::vector<ChannelBase_ *> stale_{};
+
+    std::vector<Retired_> retired_{};
+    std::size_t replaying_{0}; // Sticky replays in progress; they read a node and snapshots unlocked, so none is freed
+    std::atomic<bool> has_retired_{false};
+
+    // Only touched by the owning thread, which DispatchGuard_ binds on the first publish or drain. Until then no thread
+    // owns this Hermes and mutators leave what they retire to that first dispatch.
+    std::size_t dispatch_depth_{0};
+    bool is_owned_{false};
+    std::atomic<std::thread::id> owner_{};
+
+    // A deque, so a tap added by a tap doesn't move the one running. Taps removed while tapping are only marked, and
+    // are erased once the outermost tap_payload_() returns.
+    struct Tap_ {
+        TapID id;
+        Tap tap;
+        bool is_removed{false};
+    };
+
+    std::deque<Tap_> taps_{};
+    TapID next_tap_id_{0};
+    std::size_t tapping_{0};
+    bool has_removed_taps_{false};
+
+    std::vector<ChannelBase_ *> mailboxes_{};
+    std::vector<ChannelBase_ *> pending_{};
+    std::vector<ChannelBase_ *> draining_{};
+    bool is_draining_{false};
+
+    template <typename T>
+    static std::size_t type_index_();
+
+    template <typename T>
+    static constexpr EventInfo event_info_();
+
+    template <typename T>
+    static constexpr Coalesce coalesce_policy_();
+
+    template <typename T>
+    static constexpr std::uint32_t category_of_();
+
+    static std::mutex &registry_mutex_();
+    static std::vector<EventInfo> &registry_();
+    static std::size_t register_event_(const EventInfo &info);
+
+    template <typename T>
+    static void republish_(Hermes &hermes, std::span<const std::byte> bytes);
+
+    template <typename T>
+    void tap_payload_(const T &payload);
+
+    template <typename T>
+    Completion deliver_(Channel_<T> &channel, T &payload);
+
+    void mark_pending_(ChannelBase_ &channel);
+    void mark_stale_(ChannelBase_ &channel);
+    void rebuild_stale_();
+    void unlink_category_(ID id);
+
+    [[nodiscard]] bool is_owner_() const;
+    [[nodiscard]] bool is_owner_or_unowned_() const;
+
+    template <typename U>
+    void retire_(std::unique_ptr<U> garbage);
+    void retire_(const void *garbage, void (*destroy)(const void *garbage));
+    void reclaim_();
+    void try_reclaim_();
+    void reclaim_(std::unique_lock<std::recursive_mutex> lock);
+
+    template <typename T>
+    Channel_<T> &channel_();
+
+    template <typename T>
+    Channel_<T> *find_channel_();
+
+    void track_(ID id, std::size_t type_index);
+    void untrack_(ID id, std::size_t type_index);
+
+    template <typename T>
+    void subscribe_(ID id, const void *source, std::optional<typename Key_<T>::type> key, Receiver<T> &&receiver);
+};
+
+// Owns the ID of a single subscription and releases it when destroyed. The ID holds nothing else, so this only touches
+// the one channel it is subscribed in, in amortized constant time for a regular receiver.
+class Subscription {
+public:
+    Subscription() = default;
+    Subscription(Hermes &hermes, Hermes::ID id);
+    ~Subscription();
+
+    Subscription(const Subscription &other) = delete;
+    Subscription &operator=(const Subscription &other) = delete;
+
+    Subscription(Subscription &&other) noexcept;
+    Subscription &operator=(Subscription &&other) noexcept;
+
+    void reset();
+
+    [[nodiscard]] Hermes::ID id() const;
+    explicit operator bool() const;
+
+private:
+    Hermes *hermes_{nullptr};
+    Hermes::ID id_{0};
+};
+
+// Any number of subscriptions (and captures) sharing one ID, e.g. everything a UI panel listens to. Destroying the
+// group releases the ID, which removes all of them in one pass over just the channels they live in, rebuilding each of
+// those channels at most once.
+class SubscriptionGroup {
+public:
+    explicit SubscriptionGroup(Hermes &hermes = Hermes::instance());
+    ~SubscriptionGroup();
+
+    SubscriptionGroup(const SubscriptionGroup &other) = delete;
+    SubscriptionGroup &operator=(const SubscriptionGroup &other) = delete;
+
+    SubscriptionGroup(SubscriptionGroup &&other) noexcept;
+    SubscriptionGroup &operator=(SubscriptionGroup &&other) noexcept;
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::invocable<Func, T *>
+    void subscribe(Func &&f);
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and HasHermesSource<T> and std::invocable<Func, T *>
+    void subscribe(const void *source, Func &&f);
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and HasHermesKey<T> and std::invocable<Func, T *>
+    void subscribe_keyed(HermesKey<T> key, Func &&f);
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::copy_constructible<T> and std::invocable<Func, std::span<const T>>
+    void subscribe_batch(Func &&f);
+
+    template <typename T, typename Func>
+        requires HashHermesId<T> and std::move_constructible<T> and std::invocable<Func, const T &>
+    void subscribe_async(Func &&f, WorkerPool &pool = WorkerPool::instance());
+
+    template <typename T>
+        requires HashHermesId<T>
+    void unsubscribe();
+
+    template <typename T>
+        requires HashHermesId<T>
+    void capture();
+
+    template <typename T>
+        requires HashHermesId<T>
+    void uncapture();
+
+    template <typename Func>
+        requires std::invocable<Func, EventView>
+    void subscribe_category(std::uint32_t mask, Func &&f);
+
+    void unsubscribe_category();
+
+    [[nodiscard]] Hermes::ID id() const;
+
+private:
+    Hermes *hermes_;
+    std::optional<Hermes::ID> id_;
+};
+
+// Republishes every T published on one bus onto another, for as long as it is alive. Construct it on the thread that
+// owns `from`. A bus on the same thread is published to synchronously; for a bus owned by another thread, pass that
+// bus's mailbox<T>() (obtained on its own thread) and the payloads arrive on its next drain(). Bridging a type both
+// ways between two buses on the same thread recurses forever.
+template <typename T>
+    requires HashHermesId<T> and std::copy_constructible<T>
+class Bridge {
+public:
+    Bridge(Hermes &from, Hermes &to);
+    Bridge(Hermes &from, MpscQueue<T> &to);
+
+    Bridge(const Bridge &other) = delete;
+    Bridge &operator=(const Bridge &other) = delete;
+
+    Bridge(Bridge &&other) = delete;
+    Bridge &operator=(Bridge &&other) = delete;
+
+    // Payloads that could not be posted because the target mailbox was full
+    [[nodiscard]] std::size_t dropped() const;
+
+private:
+    Subscription subscription_{};
+    std::size_t dropped_{0};
+};
+
+template <typename T, typename Pred>
+class Hermes::NextAwaiter : Waiter_<T> {
+public:
+    NextAwaiter(Hermes &hermes, Pred pred);
+    ~NextAwaiter();
+
+    NextAwaiter(const NextAwaiter &other) = delete;
+    NextAwaiter &operator=(const NextAwaiter &other) = delete;
+
+    NextAwaiter(NextAwaiter &&other) = delete;
+    NextAwaiter &operator=(NextAwaiter &&other) = delete;
+
+    bool await_ready() const noexcept;
+    void await_suspend(std::coroutine_handle<> handle);
+    T *await_resume() const noexcept;
+
+private:
+    Hermes &hermes_;
+    Pred pred_;
 };
 } // namespace theia
 
@@ -77,7 +869,15 @@ inline theia::Hermes &theia::Hermes::instance() {
     return instance;
 }
 
+inline theia::Hermes &theia::Hermes::thread_instance() {
+    thread_local Hermes instance;
+    return instance;
+}
+
+inline theia::Hermes::~Hermes() { reclaim_(); }
+
 inline theia::Hermes::ID theia::Hermes::acquire_id() {
+    std::scoped_lock lock(mutex_);
     if (recycled_ids_.empty()) return next_id_++;
 
     const auto id = recycled_ids_.back();
@@ -86,11 +886,20 @@ inline theia::Hermes::ID theia::Hermes::acquire_id() {
 }
 
 inline void theia::Hermes::release_id(const ID id) {
-    for (auto &receivers : receivers_ | std::views::values)
-        if (receivers.size() > id) receivers[id] = nullptr;
-
-    for (auto &capture : captures_ | std::views::values)
-        if (capture && *capture == id) capture.reset();
+    const auto guard = MutationGuard_(*this);
+    if (channels_by_id_.size() > id) {
+        for (const auto type_index : channels_by_id_[id]) {
+            auto &channel = *channels_[type_index];
+            channel.erase(*this, id);
+            if (channel.capture == id) {
+                channel.capture.reset();
+                mark_stale_(channel);
+            }
+        }
+        channels_by_id_[id].clear();
+    }
+    unlink_category_(id);
+    rebuild_stale_();
 
     recycled_ids_.push_back(id);
 }
@@ -98,48 +907,1335 @@ inline void theia::Hermes::release_id(const ID id) {
 template <typename T, typename Func>
     requires theia::HashHermesId<T> and std::invocable<Func, T *>
 void theia::Hermes::subscribe(ID id, Func &&f) {
-    auto &receivers = receivers_[T::HERMES_ID];
-    if (receivers.size() <= id) receivers.resize(id + 1);
-    receivers[id] = [f = std::forward<Func>(f)](const Payload buffer) { f(reinterpret_cast<T *>(buffer.data())); };
+    subscribe_<T>(id, nullptr, std::nullopt, Receiver<T>(std::forward<Func>(f)));
 }
 
-template <typename T>
-    requires theia::HashHermesId<T>
-void theia::Hermes::unsubscribe(ID id) {
-    auto &receivers = receivers_[T::HERMES_ID];
-    if (receivers.size() > id) receivers[id] = nullptr;
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::invocable<Func, T *>
+theia::Subscription theia::Hermes::subscribe(Func &&f) {
+    const auto id = acquire_id();
+    subscribe<T>(id, std::forward<Func>(f));
+    return Subscription(*this, id);
 }
 
-template <typename T, typename... Args>
-    requires theia::HashHermesId<T>
-void theia::Hermes::publish(Args &&...args) {
-    const auto payload = make_payload_<T>(std::forward<Args>(args)...);
-    if (auto cap_id_opt = captures_[T::HERMES_ID]; cap_id_opt) {
-        if (receivers_[T::HERMES_ID].size() > *cap_id_opt) {
-            if (auto &r = receivers_[T::HERMES_ID][*cap_id_opt]; r) r(payload);
-        }
-    } else {
-        for (auto &r : receivers_[T::HERMES_ID])
-            if (r) r(payload);
-    }
-    operator delete(payload.data(), payload.size());
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and theia::HasHermesSource<T> and std::invocable<Func, T *>
+void theia::Hermes::subscribe(ID id, const void *source, Func &&f) {
+    subscribe_<T>(id, source, std::nullopt, Receiver<T>(std::forward<Func>(f)));
 }
 
-template <typename T>
-    requires theia::HashHermesId<T>
-void theia::Hermes::capture(ID id) {
-    captures_[T::HERMES_ID] = id;
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and theia::HasHermesKey<T> and std::invocable<Func, T *>
+void theia::Hermes::subscribe_keyed(ID id, HermesKey<T> key, Func &&f) {
+    subscribe_<T>(id, nullptr, std::move(key), Receiver<T>(std::forward<Func>(f)));
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and theia::HasHermesKey<T> and std::invocable<Func, T *>
+theia::Subscription theia::Hermes::subscribe_keyed(HermesKey<T> key, Func &&f) {
+    const auto id = acquire_id();
+    subscribe_keyed<T>(id, std::move(key), std::forward<Func>(f));
+    return Subscription(*this, id);
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::copy_constructible<T> and std::invocable<Func, std::span<const T>>
+void theia::Hermes::subscribe_batch(ID id, Func &&f) {
+    const auto guard = MutationGuard_(*this);
+    auto &channel = channel_<T>();
+    auto receiver = std::make_unique<Held_<BatchReceiver<T>>>(BatchReceiver<T>(std::forward<Func>(f)));
+    if (const auto it = std::ranges::find(channel.batch_ids, id); it != channel.batch_ids.end()) {
+        auto &held = channel.batch_receivers[it - channel.batch_ids.begin()];
+        retire_(std::exchange(held, std::move(receiver)));
+    } else {
+        channel.batch_ids.push_back(id);
+        channel.batch_receivers.push_back(std::move(receiver));
+    }
+    track_(id, type_index_<T>());
+    channel.rebuild(*this);
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::move_constructible<T> and std::invocable<Func, const T &>
+void theia::Hermes::subscribe_async(ID id, Func &&f, WorkerPool &pool) {
+    const auto guard = MutationGuard_(*this);
+    auto &channel = channel_<T>();
+    auto receiver = std::make_shared<Held_<AsyncReceiver<T>>>(AsyncReceiver<T>(std::forward<Func>(f)));
+    if (const auto it = std::ranges::find(channel.async_ids, id); it != channel.async_ids.end()) {
+        const auto i = static_cast<std::size_t>(it - channel.async_ids.begin());
+        channel.async_receivers[i]->live.store(false, std::memory_order_release);
+        channel.async_receivers[i] = std::move(receiver);
+        channel.async_pools[i] = &pool;
+    } else {
+        channel.async_ids.push_back(id);
+        channel.async_receivers.push_back(std::move(receiver));
+        channel.async_pools.push_back(&pool);
+    }
+    track_(id, type_index_<T>());
+    channel.rebuild(*this);
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::move_constructible<T> and std::invocable<Func, const T &>
+theia::Subscription theia::Hermes::subscribe_async(Func &&f, WorkerPool &pool) {
+    const auto id = acquire_id();
+    subscribe_async<T>(id, std::forward<Func>(f), pool);
+    return Subscription(*this, id);
 }
 
 template <typename T>
     requires theia::HashHermesId<T>
-void theia::Hermes::uncapture(ID id, bool force) {
-    if (force || captures_[T::HERMES_ID] && *captures_[T::HERMES_ID] == id) captures_[T::HERMES_ID].reset();
+void theia::Hermes::unsubscribe(ID id) {
+    const auto guard = MutationGuard_(*this);
+    auto *channel = find_channel_<T>();
+    if (!channel || !channel->erase(*this, id)) return;
+    untrack_(id, type_index_<T>());
+    rebuild_stale_();
+}
+
+template <typename Func>
+    requires std::invocable<Func, theia::EventView>
+void theia::Hermes::subscribe_category(const ID id, const std::uint32_t mask, Func &&f) {
+    const auto guard = MutationGuard_(*this);
+    unlink_category_(id);
+
+    auto &listener = *category_listeners_.emplace_back(
+        std::make_unique<CategoryListener_>(id, mask, CategoryReceiver(std::forward<Func>(f))));
+    category_listener_count_.store(category_listeners_.size(), std::memory_order_relaxed);
+    if (category_ids_.size() <= id) category_ids_.resize(id + 1);
+    category_ids_[id] = true;
+    for (auto &channel : channels_) {
+        if (!channel || !(channel->category & mask)) continue;
+        channel->category_listeners.push_back(&listener);
+        mark_stale_(*channel);
+    }
+    rebuild_stale_();
+}
+
+template <typename Func>
+    requires std::invocable<Func, theia::EventView>
+theia::Subscription theia::Hermes::subscribe_category(const std::uint32_t mask, Func &&f) {
+    const auto id = acquire_id();
+    subscribe_category(id, mask, std::forward<Func>(f));
+    return Subscription(*this, id);
+}
+
+inline void theia::Hermes::unsubscribe_category(const ID id) {
+    const auto guard = MutationGuard_(*this);
+    unlink_category_(id);
+    rebuild_stale_();
 }
 
 template <typename T, typename... Args>
-std::span<std::byte> theia::Hermes::make_payload_(Args &&...args) {
-    return std::span(reinterpret_cast<std::byte *>(new T{std::forward<Args>(args)...}), sizeof(T));
+    requires theia::HashHermesId<T>
+theia::Completion theia::Hermes::publish(Args &&...args) {
+    auto *channel = find_channel_<T>();
+    if constexpr (IsHermesSticky<T>) {
+        // The latest payload is kept whether or not anything receives it yet
+        if (!channel) channel = &channel_<T>();
+    } else if constexpr (category_of_<T>() != 0) {
+        // A type nothing has touched yet has no channel for listeners to be linked into, so make one
+        if (!channel && category_listener_count_.load(std::memory_order_relaxed) != 0) channel = &channel_<T>();
+    }
+    if (!channel && taps_.empty()) return {};
+
+    const auto guard = DispatchGuard_(*this);
+
+    // The payload lives on this frame for the duration of the dispatch, so publishing never touches the heap and the
+    // payload's destructor runs once every receiver has seen it. Only async receivers move it onto the heap.
+    T payload{std::forward<Args>(args)...};
+
+    // With nothing but plain receivers, which is the common case, skip every other check deliver_() makes
+    if (channel && taps_.empty()) [[likely]] {
+        if (const auto &view = channel->read(); view.features == 0 && !channel->waiters) [[likely]] {
+#if defined(THEIA_HERMES_STATS)
+            ++channel->published;
+#endif
+            if constexpr (IsHermesSticky<T>) channel->remember(payload);
+            for (auto *node : view.receivers.entries())
+                Channel_<T>::invoke(*node, &payload);
+            return {};
+        }
+    }
+
+    if (!taps_.empty()) tap_payload_(payload);
+    return channel ? deliver_(*channel, payload) : Completion{};
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+void theia::Hermes::capture(ID id) {
+    const auto guard = MutationGuard_(*this);
+    auto &channel = channel_<T>();
+    const auto previous = channel.capture;
+    channel.capture = id;
+    if (previous && *previous != id) untrack_(*previous, type_index_<T>());
+    track_(id, type_index_<T>());
+    channel.rebuild(*this);
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+void theia::Hermes::uncapture(ID id, bool force) {
+    const auto guard = MutationGuard_(*this);
+    auto *channel = find_channel_<T>();
+    if (!channel || !channel->capture) return;
+
+    if (force || *channel->capture == id) {
+        const auto previous = *channel->capture;
+        channel->capture.reset();
+        untrack_(previous, type_index_<T>());
+        channel->rebuild(*this);
+    }
+}
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::move_constructible<T>
+void theia::Hermes::set_delivery(const Delivery delivery) {
+    const auto guard = MutationGuard_(*this);
+    auto &channel = channel_<T>();
+    if (channel.delivery == delivery) return;
+    channel.delivery = delivery;
+    channel.rebuild(*this);
+}
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::move_constructible<T>
+theia::MpscQueue<T> &theia::Hermes::mailbox(const std::size_t capacity) {
+    auto &channel = channel_<T>();
+    if (!channel.mailbox) {
+        channel.mailbox = std::make_unique<MpscQueue<T>>(capacity);
+        mailboxes_.push_back(&channel);
+    }
+    return *channel.mailbox;
+}
+
+inline void theia::Hermes::drain() {
+    if (is_draining_) return;
+    is_draining_ = true;
+    const auto guard = DispatchGuard_(*this);
+
+    // By index and up to the count on entry: a receiver may create a mailbox, which is pumped from the next call
+    for (std::size_t i = 0, count = mailboxes_.size(); i < count; ++i)
+        mailboxes_[i]->pump(*this);
+
+    // Every channel sets its payloads aside before any is dispatched, so whichever order they are visited in, a payload
+    // a receiver publishes meanwhile is queued for the next call rather than joining a channel not yet reached
+    std::swap(pending_, draining_);
+    for (auto *channel : draining_) {
+        channel->is_pending = false;
+        channel->stage();
+    }
+    for (auto *channel : draining_)
+        channel->drain();
+    draining_.clear();
+
+    is_draining_ = false;
+}
+
+template <typename T>
+    requires theia::HashHermesId<T> and theia::IsHermesSticky<T>
+const T *theia::Hermes::latest() {
+    const auto *channel = find_channel_<T>();
+    return channel && !channel->sticky.empty() ? &channel->sticky.back() : nullptr;
+}
+
+template <typename T>
+    requires theia::HashHermesId<T> and theia::IsHermesSticky<T> and theia::HasHermesSource<T>
+const T *theia::Hermes::latest(const void *source) {
+    const auto *channel = find_channel_<T>();
+    if (!channel) return nullptr;
+
+    const auto it = std::ranges::find_if(channel->sticky, [&](const T &payload) {
+        return payload.hermes_source() == source;
+    });
+    return it != channel->sticky.end() ? &*it : nullptr;
+}
+
+inline void theia::Hermes::forget(const void *source) {
+    assert(is_owner_or_unowned_() && "Hermes::forget() called from a thread that does not own it");
+    std::scoped_lock lock(mutex_);
+    for (auto &channel : channels_)
+        if (channel) channel->forget(source);
+}
+
+template <typename T, typename Pred>
+    requires theia::HashHermesId<T> and std::predicate<Pred &, const T &>
+theia::Hermes::NextAwaiter<T, Pred> theia::Hermes::next(Pred pred) {
+    return NextAwaiter<T, Pred>(*this, std::move(pred));
+}
+
+inline theia::Subscription::Subscription(Hermes &hermes, const Hermes::ID id)
+    : hermes_(&hermes),
+      id_(id) {}
+
+inline theia::Subscription::~Subscription() { reset(); }
+
+inline theia::Subscription::Subscription(Subscription &&other) noexcept
+    : hermes_(std::exchange(other.hermes_, nullptr)),
+      id_(other.id_) {}
+
+inline theia::Subscription &theia::Subscription::operator=(Subscription &&other) noexcept {
+    if (this != &other) {
+        reset();
+        hermes_ = std::exchange(other.hermes_, nullptr);
+        id_ = other.id_;
+    }
+    return *this;
+}
+
+inline void theia::Subscription::reset() {
+    if (hermes_) std::exchange(hermes_, nullptr)->release_id(id_);
+}
+
+inline theia::Hermes::ID theia::Subscription::id() const { return id_; }
+
+inline theia::Subscription::operator bool() const { return hermes_ != nullptr; }
+
+inline theia::SubscriptionGroup::SubscriptionGroup(Hermes &hermes)
+    : hermes_(&hermes),
+      id_(hermes.acquire_id()) {}
+
+inline theia::SubscriptionGroup::~SubscriptionGroup() {
+    if (id_) hermes_->release_id(*id_);
+}
+
+inline theia::SubscriptionGroup::SubscriptionGroup(SubscriptionGroup &&other) noexcept
+    : hermes_(other.hermes_),
+      id_(std::exchange(other.id_, std::nullopt)) {}
+
+inline theia::SubscriptionGroup &theia::SubscriptionGroup::operator=(SubscriptionGroup &&other) noexcept {
+    if (this != &other) {
+        if (id_) hermes_->release_id(*id_);
+        hermes_ = other.hermes_;
+        id_ = std::exchange(other.id_, std::nullopt);
+    }
+    return *this;
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::invocable<Func, T *>
+void theia::SubscriptionGroup::subscribe(Func &&f) {
+    hermes_->subscribe<T>(*id_, std::forward<Func>(f));
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and theia::HasHermesSource<T> and std::invocable<Func, T *>
+void theia::SubscriptionGroup::subscribe(const void *source, Func &&f) {
+    hermes_->subscribe<T>(*id_, source, std::forward<Func>(f));
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and theia::HasHermesKey<T> and std::invocable<Func, T *>
+void theia::SubscriptionGroup::subscribe_keyed(HermesKey<T> key, Func &&f) {
+    hermes_->subscribe_keyed<T>(*id_, std::move(key), std::forward<Func>(f));
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::copy_constructible<T> and std::invocable<Func, std::span<const T>>
+void theia::SubscriptionGroup::subscribe_batch(Func &&f) {
+    hermes_->subscribe_batch<T>(*id_, std::forward<Func>(f));
+}
+
+template <typename T, typename Func>
+    requires theia::HashHermesId<T> and std::move_constructible<T> and std::invocable<Func, const T &>
+void theia::SubscriptionGroup::subscribe_async(Func &&f, WorkerPool &pool) {
+    hermes_->subscribe_async<T>(*id_, std::forward<Func>(f), pool);
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+void theia::SubscriptionGroup::unsubscribe() {
+    hermes_->unsubscribe<T>(*id_);
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+void theia::SubscriptionGroup::capture() {
+    hermes_->capture<T>(*id_);
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+void theia::SubscriptionGroup::uncapture() {
+    hermes_->uncapture<T>(*id_);
+}
+
+template <typename Func>
+    requires std::invocable<Func, theia::EventView>
+void theia::SubscriptionGroup::subscribe_category(const std::uint32_t mask, Func &&f) {
+    hermes_->subscribe_category(*id_, mask, std::forward<Func>(f));
+}
+
+inline void theia::SubscriptionGroup::unsubscribe_category() { hermes_->unsubscribe_category(*id_); }
+
+inline theia::Hermes::ID theia::SubscriptionGroup::id() const { return *id_; }
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::copy_constructible<T>
+theia::Bridge<T>::Bridge(Hermes &from, Hermes &to) {
+    subscription_ = from.subscribe<T>([&to](T *payload) { to.publish<T>(*payload); });
+}
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::copy_constructible<T>
+theia::Bridge<T>::Bridge(Hermes &from, MpscQueue<T> &to) {
+    subscription_ = from.subscribe<T>([this, &to](T *payload) {
+        if (!to.try_emplace(*payload)) ++dropped_;
+    });
+}
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::copy_constructible<T>
+std::size_t theia::Bridge<T>::dropped() const {
+    return dropped_;
+}
+
+#if defined(THEIA_HERMES_STATS)
+inline std::vector<theia::EventStats> theia::Hermes::stats() const {
+    assert(is_owner_or_unowned_() && "Hermes::stats() called from a thread that does not own it");
+    std::scoped_lock lock(mutex_);
+    std::vector<EventStats> result{};
+    for (std::size_t index = 0; index < channels_.size(); ++index) {
+        const auto *channel = channels_[index].get();
+        if (!channel) continue;
+
+        auto &entry = result.emplace_back(EventStats{index, channel->published, {}});
+        channel->collect_stats(entry);
+    }
+    return result;
+}
+
+inline void theia::Hermes::reset_stats() {
+    assert(is_owner_or_unowned_() && "Hermes::reset_stats() called from a thread that does not own it");
+    std::scoped_lock lock(mutex_);
+    for (auto &channel : channels_) {
+        if (!channel) continue;
+        channel->published = 0;
+        channel->reset_stats();
+    }
+}
+
+inline void theia::HandlerStats::record(const std::chrono::nanoseconds elapsed) {
+    ++calls;
+    total += elapsed;
+    max = std::max(max, elapsed);
+
+    const auto micros =
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    const auto bucket = static_cast<std::size_t>(std::bit_width(micros));
+    ++histogram[std::min(bucket, BUCKETS - 1)];
+}
+#endif
+
+template <typename T>
+const std::size_t theia::internal::HermesRegistration<T>::index = Hermes::type_index_<T>();
+
+// Small enough to inline into publish(), which then costs a guard check and a load rather than a call
+template <typename T>
+inline std::size_t theia::Hermes::type_index_() {
+    static constexpr EventInfo info = event_info_<T>();
+    static const std::size_t index = register_event_(info);
+    return index;
+}
+
+template <typename T>
+constexpr theia::EventInfo theia::Hermes::event_info_() {
+    constexpr std::string_view name = [] {
+        if constexpr (requires { T::HERMES_NAME; }) {
+            return T::HERMES_NAME;
+        } else {
+            return std::string_view{};
+        }
+    }();
+    constexpr auto republish = [] {
+        if constexpr (std::is_trivially_copyable_v<T> and std::copy_constructible<T>) {
+            return &republish_<T>;
+        } else {
+            return static_cast<void (*)(Hermes &, std::span<const std::byte>)>(nullptr);
+        }
+    }();
+    return EventInfo{0, T::HERMES_ID, name, sizeof(T), alignof(T), category_of_<T>(), republish};
+}
+
+template <typename T>
+void theia::Hermes::republish_(Hermes &hermes, const std::span<const std::byte> bytes) {
+    if (bytes.size() != sizeof(T)) return;
+
+    alignas(T) std::byte storage[sizeof(T)];
+    std::memcpy(storage, bytes.data(), sizeof(T));
+    hermes.publish<T>(*std::launder(reinterpret_cast<const T *>(storage)));
+}
+
+template <typename T>
+void theia::Hermes::tap_payload_(const T &payload) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // By index and up to the count on entry, so taps added meanwhile start with the next payload
+        ++tapping_;
+        for (std::size_t i = 0, count = taps_.size(); i < count; ++i)
+            if (!taps_[i].is_removed) taps_[i].tap(T::HERMES_ID, std::as_bytes(std::span(&payload, 1)));
+        if (--tapping_ == 0 && has_removed_taps_) {
+            std::erase_if(taps_, [](const Tap_ &entry) { return entry.is_removed; });
+            has_removed_taps_ = false;
+        }
+    }
+}
+
+template <typename T>
+theia::Completion theia::Hermes::deliver_(Channel_<T> &channel, T &payload) {
+#if defined(THEIA_HERMES_STATS)
+    ++channel.published;
+#endif
+    if constexpr (IsHermesSticky<T>) {
+        // A deferred payload is remembered once drain() dispatches it; remembering it now would replay it to a receiver
+        // subscribing before that drain(), which would then be handed it a second time
+        if (channel.delivery != Delivery::Deferred) channel.remember(payload);
+    }
+
+    if constexpr (std::copy_constructible<T>) {
+        if (!channel.read().batch_receivers.empty()) {
+            channel.batch.push_back(payload);
+            mark_pending_(channel);
+        }
+    }
+
+    if constexpr (std::move_constructible<T>) {
+        if (channel.delivery == Delivery::Deferred) {
+            channel.enqueue(std::move(payload));
+            mark_pending_(channel);
+            return {};
+        }
+    }
+
+    channel.dispatch(&payload);
+    if constexpr (std::move_constructible<T>) {
+        if (!channel.read().async_receivers.empty()) return channel.dispatch_async(std::move(payload));
+    }
+    return {};
+}
+
+inline void theia::Hermes::mark_pending_(ChannelBase_ &channel) {
+    if (channel.is_pending) return;
+    channel.is_pending = true;
+    pending_.push_back(&channel);
+}
+
+inline void theia::Hermes::mark_stale_(ChannelBase_ &channel) {
+    if (channel.is_stale) return;
+    channel.is_stale = true;
+    stale_.push_back(&channel);
+}
+
+inline void theia::Hermes::rebuild_stale_() {
+    for (auto *channel : stale_) {
+        channel->is_stale = false;
+        channel->rebuild(*this);
+    }
+    stale_.clear();
+}
+
+// Leaves the channels it unlinks the listener from stale, for the caller to rebuild
+inline void theia::Hermes::unlink_category_(const ID id) {
+    if (category_ids_.size() <= id || !category_ids_[id]) return;
+    category_ids_[id] = false;
+
+    const auto it = std::ranges::find_if(category_listeners_, [&](const auto &listener) { return listener->id == id; });
+    if (it == category_listeners_.end()) return;
+
+    for (auto &channel : channels_)
+        if (channel && std::erase(channel->category_listeners, it->get()) != 0) mark_stale_(*channel);
+    retire_(std::move(*it));
+    category_listeners_.erase(it);
+    category_listener_count_.store(category_listeners_.size(), std::memory_order_relaxed);
+}
+
+template <typename U>
+void theia::Hermes::retire_(std::unique_ptr<U> garbage) {
+    if constexpr (requires { garbage->live; }) garbage->live.store(false, std::memory_order_release);
+    retire_(garbage.release(), [](const void *p) { delete static_cast<const U *>(p); });
+}
+
+inline void theia::Hermes::retire_(const void *garbage, void (*destroy)(const void *garbage)) {
+    retired_.emplace_back(garbage, destroy);
+    has_retired_.store(true, std::memory_order_relaxed);
+}
+
+inline void theia::Hermes::reclaim_() { reclaim_(std::unique_lock(mutex_)); }
+
+// Dispatch never waits for a mutator, which may be a long rebuild or a thread waiting on the owner in turn
+inline void theia::Hermes::try_reclaim_() {
+    if (auto lock = std::unique_lock(mutex_, std::try_to_lock)) reclaim_(std::move(lock));
+}
+
+inline void theia::Hermes::reclaim_(std::unique_lock<std::recursive_mutex> lock) {
+    if (replaying_ > 0) return;
+    std::vector<Retired_> garbage{};
+    garbage.swap(retired_);
+    has_retired_.store(false, std::memory_order_relaxed);
+    lock.unlock();
+
+    // Outside the lock, as the captures of a receiver may do anything on the way out
+    for (const auto &retired : garbage)
+        retired.destroy(retired.garbage);
+}
+
+inline theia::Hermes::DispatchGuard_::DispatchGuard_(Hermes &hermes)
+    : hermes(hermes) {
+    if (!hermes.is_owned_) [[unlikely]] {
+        hermes.owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        hermes.is_owned_ = true;
+    }
+    assert(hermes.is_owner_() && "Hermes published to or drained from a thread that does not own it");
+    ++hermes.dispatch_depth_;
+}
+
+inline theia::Hermes::DispatchGuard_::~DispatchGuard_() {
+    if (--hermes.dispatch_depth_ == 0 && hermes.has_retired_.load(std::memory_order_relaxed)) [[unlikely]]
+        hermes.try_reclaim_();
+}
+
+inline theia::Hermes::MutationGuard_::MutationGuard_(Hermes &hermes)
+    : hermes(hermes),
+      lock(hermes.mutex_) {}
+
+inline theia::Hermes::MutationGuard_::~MutationGuard_() {
+    lock.unlock();
+    if (!hermes.has_retired_.load(std::memory_order_relaxed)) return;
+    if (hermes.is_owner_() && hermes.dispatch_depth_ == 0) hermes.reclaim_();
+}
+
+inline bool theia::Hermes::is_owner_() const {
+    return owner_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+// No thread owns this Hermes until the first publish or drain binds one; until then, any thread passes
+inline bool theia::Hermes::is_owner_or_unowned_() const {
+    const auto owner = owner_.load(std::memory_order_relaxed);
+    return owner == std::thread::id{} || owner == std::this_thread::get_id();
+}
+
+template <typename T>
+constexpr theia::Coalesce theia::Hermes::coalesce_policy_() {
+    if constexpr (requires { T::HERMES_COALESCE_POLICY; }) {
+        static_assert(T::HERMES_COALESCE_POLICY != Coalesce::Accumulate || requires(T &t, const T &next) {
+            t.accumulate(next);
+        }, "Accumulate requires T::accumulate(const T &)");
+        return T::HERMES_COALESCE_POLICY;
+    } else {
+        return Coalesce::None;
+    }
+}
+
+template <typename T>
+constexpr std::uint32_t theia::Hermes::category_of_() {
+    if constexpr (requires { T::HERMES_CATEGORY_BITS; }) {
+        return T::HERMES_CATEGORY_BITS;
+    } else {
+        return 0;
+    }
+}
+
+inline theia::Hermes::TapID theia::Hermes::add_tap(Tap tap) {
+    const auto id = next_tap_id_++;
+    taps_.push_back(Tap_{id, std::move(tap)});
+    return id;
+}
+
+inline void theia::Hermes::remove_tap(const TapID id) {
+    if (tapping_ == 0) {
+        std::erase_if(taps_, [&](const Tap_ &entry) { return entry.id == id; });
+        return;
+    }
+    for (auto &entry : taps_)
+        if (entry.id == id) entry.is_removed = true;
+    has_removed_taps_ = true;
+}
+
+inline std::vector<theia::EventInfo> theia::Hermes::event_types() {
+    std::scoped_lock lock(registry_mutex_());
+    return registry_();
+}
+
+inline std::optional<theia::EventInfo> theia::Hermes::find_event_type(const std::uint32_t id) {
+    std::scoped_lock lock(registry_mutex_());
+    for (const auto &info : registry_())
+        if (info.id == id) return info;
+    return std::nullopt;
+}
+
+inline std::mutex &theia::Hermes::registry_mutex_() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::vector<theia::EventInfo> &theia::Hermes::registry_() {
+    static std::vector<EventInfo> registry;
+    return registry;
+}
+
+inline std::size_t theia::Hermes::register_event_(const EventInfo &info) {
+    std::scoped_lock lock(registry_mutex_());
+    auto &registry = registry_();
+
+    // Two types sharing an ID would have their payloads reinterpreted as each other, so refuse the second one. For
+    // types from MAKE_HERMES_ID this runs during static initialization, so the program terminates before main().
+    for (const auto &other : registry)
+        if (other.id == info.id)
+            throw std::runtime_error("Hermes ID collision between '" + std::string(other.name) + "' and '" +
+                                     std::string(info.name) + "'");
+
+    registry.push_back(info);
+    registry.back().index = registry.size() - 1;
+    return registry.back().index;
+}
+
+template <typename T>
+theia::Hermes::Channel_<T> &theia::Hermes::channel_() {
+    std::scoped_lock lock(mutex_);
+    const auto index = type_index_<T>();
+    if (channels_.size() <= index) channels_.resize(index + 1);
+
+    auto &channel = channels_[index];
+    if (!channel) {
+        channel = std::make_unique<Channel_<T>>();
+        if constexpr (category_of_<T>() != 0) {
+            channel->category = category_of_<T>();
+            for (auto &listener : category_listeners_)
+                if (listener->mask & channel->category) channel->category_listeners.push_back(listener.get());
+        }
+        channel->rebuild(*this);
+
+        auto table = std::make_unique<ChannelTable_>();
+        table->reserve(channels_.size());
+        for (const auto &c : channels_)
+            table->push_back(c.get());
+        table_.store(table.get(), std::memory_order_release);
+        if (current_table_) retire_(std::move(current_table_));
+        current_table_ = std::move(table);
+    }
+    return static_cast<Channel_<T> &>(*channel);
+}
+
+template <typename T>
+theia::Hermes::Channel_<T> *theia::Hermes::find_channel_() {
+    const auto index = type_index_<T>();
+    const auto *table = table_.load(std::memory_order_acquire);
+    return table && table->size() > index ? static_cast<Channel_<T> *>((*table)[index]) : nullptr;
+}
+
+inline void theia::Hermes::track_(const ID id, const std::size_t type_index) {
+    if (channels_by_id_.size() <= id) channels_by_id_.resize(id + 1);
+
+    auto &tracked = channels_by_id_[id];
+    if (std::ranges::find(tracked, type_index) == tracked.end()) tracked.push_back(type_index);
+}
+
+inline void theia::Hermes::untrack_(const ID id, const std::size_t type_index) {
+    if (channels_by_id_.size() <= id) return;
+
+    // Only forget the channel once the ID holds no receiver of any kind and not the capture in it
+    const auto &channel = *channels_[type_index];
+    if (channel.holds(id) || channel.capture == id) return;
+    if (std::ranges::find(channel.batch_ids, id) != channel.batch_ids.end()) return;
+    if (std::ranges::find(channel.async_ids, id) != channel.async_ids.end()) return;
+
+    auto &tracked = channels_by_id_[id];
+    if (const auto it = std::ranges::find(tracked, type_index); it != tracked.end()) {
+        *it = tracked.back();
+        tracked.pop_back();
+    }
+}
+
+template <typename T>
+void theia::Hermes::subscribe_(const ID id,
+                               const void *source,
+                               std::optional<typename Key_<T>::type> key,
+                               Receiver<T> &&receiver) {
+    Channel_<T> *channel = nullptr;
+    Node_<T> *node = nullptr;
+    {
+        const auto guard = MutationGuard_(*this);
+        channel = &channel_<T>();
+        node = &channel->insert(*this, id, source, std::move(key), std::move(receiver));
+        track_(id, type_index_<T>());
+        rebuild_stale_();
+        if constexpr (IsHermesSticky<T>) ++replaying_;
+    }
+
+    // Unlocked, so the receivers replayed to can't hold up the owning thread, nor deadlock by waiting on it
+    if constexpr (IsHermesSticky<T>) channel->replay(*this, id, *node);
+}
+
+template <typename T>
+void theia::Hermes::Waiter_<T>::link(Waiter_ *&head) {
+    next = head;
+    if (head) head->prev_next = &next;
+    head = this;
+    prev_next = &head;
+}
+
+template <typename T>
+void theia::Hermes::Waiter_<T>::unlink() {
+    if (!prev_next) return;
+
+    *prev_next = next;
+    if (next) next->prev_next = prev_next;
+    next = nullptr;
+    prev_next = nullptr;
+}
+
+template <typename T, typename Pred>
+theia::Hermes::NextAwaiter<T, Pred>::NextAwaiter(Hermes &hermes, Pred pred)
+    : hermes_(hermes),
+      pred_(std::move(pred)) {
+    this->accepts = [](Waiter_<T> *self, const T &payload) -> bool {
+        return static_cast<NextAwaiter *>(self)->pred_(payload);
+    };
+}
+
+template <typename T, typename Pred>
+theia::Hermes::NextAwaiter<T, Pred>::~NextAwaiter() {
+    // A coroutine destroyed while suspended must not stay reachable from the channel
+    this->unlink();
+}
+
+template <typename T, typename Pred>
+bool theia::Hermes::NextAwaiter<T, Pred>::await_ready() const noexcept {
+    return false;
+}
+
+template <typename T, typename Pred>
+void theia::Hermes::NextAwaiter<T, Pred>::await_suspend(const std::coroutine_handle<> handle) {
+    this->handle = handle;
+    this->link(hermes_.channel_<T>().waiters);
+}
+
+template <typename T, typename Pred>
+T *theia::Hermes::NextAwaiter<T, Pred>::await_resume() const noexcept {
+    return this->payload;
+}
+
+inline bool theia::Hermes::ChannelBase_::holds(const ID id) const { return slots.size() > id && slots[id] != NO_SLOT; }
+
+template <typename T>
+theia::Hermes::Channel_<T>::~Channel_() {
+    // Frames still waiting here outlive the channel; detach them so their awaiters don't unlink into freed memory
+    while (waiters)
+        waiters->unlink();
+}
+
+template <typename T>
+const typename theia::Hermes::Channel_<T>::Snapshot &theia::Hermes::Channel_<T>::read() const {
+    return *snapshot.load(std::memory_order_acquire);
+}
+
+template <typename T>
+theia::Hermes::Node_<T> &theia::Hermes::Arena_<T>::acquire() {
+    if (!released.empty() && released.front()->vacant.load(std::memory_order_acquire)) {
+        auto &node = *released.front();
+        released.pop_front();
+        node.vacant.store(false, std::memory_order_relaxed);
+        return node;
+    }
+
+    if (chunks.empty() || used == chunk_size) {
+        chunk_size = chunks.empty() ? FIRST_CHUNK : std::min(chunk_size * 2, LAST_CHUNK);
+        chunks.push_back(std::make_unique<Node_<T>[]>(chunk_size));
+        used = 0;
+    }
+    auto &node = chunks.back()[used++];
+    node.vacant.store(false, std::memory_order_relaxed);
+    return node;
+}
+
+// Clearing the node destroys the receiver's captures, so it waits for the quiescent point like any other garbage
+template <typename T>
+void theia::Hermes::Arena_<T>::release(Hermes &hermes, Node_<T> &node) {
+    released.push_back(&node);
+    hermes.retire_(&node, [](const void *p) {
+        auto &node = *static_cast<Node_<T> *>(const_cast<void *>(p));
+        node.receiver = Receiver<T>{};
+        node.key.reset();
+        node.vacant.store(true, std::memory_order_release);
+    });
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::Nodes::seal() {
+    size.store(items.size(), std::memory_order_relaxed);
+    items.resize(std::max<std::size_t>(items.size() * 2, 4));
+}
+
+template <typename T>
+bool theia::Hermes::Channel_<T>::Nodes::append(Node_<T> *node) {
+    const auto n = size.load(std::memory_order_relaxed);
+    if (n == items.size()) return false;
+
+    items[n] = node;
+    size.store(n + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::span<theia::Hermes::Node_<T> *const> theia::Hermes::Channel_<T>::Nodes::entries() const {
+    return {items.data(), size.load(std::memory_order_acquire)};
+}
+
+// Appends the receiver to the current snapshot when its list there has room, and marks the channel stale otherwise
+template <typename T>
+theia::Hermes::Node_<T> &theia::Hermes::Channel_<T>::insert(Hermes &hermes,
+                                                             const ID id,
+                                                             const void *source,
+                                                             std::optional<Key> key,
+                                                             Receiver<T> &&receiver) {
+    auto &node = arena.acquire();
+    node.receiver = std::move(receiver);
+    node.source = source;
+    node.key = std::move(key);
+#if defined(THEIA_HERMES_STATS)
+    node.stats = HandlerStats{};
+#endif
+    node.live.store(true, std::memory_order_relaxed);
+
+    if (holds(id)) {
+        bury(hermes, *std::exchange(nodes[slots[id]], &node));
+    } else {
+        if (slots.size() <= id) slots.resize(id + 1, NO_SLOT);
+        slots[id] = ids.size();
+        ids.push_back(id);
+        nodes.push_back(&node);
+    }
+
+    // The capturing ID's receiver is singled out in the snapshot, so replacing it takes a rebuild
+    auto *list = capture == id ? nullptr : &current->receivers;
+    if constexpr (HasHermesKey<T>) {
+        if (list && node.key) {
+            const auto it = current->keyed.find(*node.key);
+            list = it != current->keyed.end() ? &it->second : nullptr;
+        }
+    }
+    if constexpr (HasHermesSource<T>) {
+        if (list && !node.key && node.source) {
+            const auto it = current->scoped.find(node.source);
+            list = it != current->scoped.end() ? &it->second : nullptr;
+        }
+    }
+    if (!list || !list->append(&node)) hermes.mark_stale_(*this);
+    return node;
+}
+
+// Leaves a removed receiver listed but dead, and compacts once the dead outnumber the living, so that each removal
+// costs amortized constant time
+template <typename T>
+void theia::Hermes::Channel_<T>::bury(Hermes &hermes, Node_<T> &node) {
+    node.live.store(false, std::memory_order_release);
+    buried.push_back(&node);
+    if (buried.size() > ids.size()) hermes.mark_stale_(*this);
+}
+
+// Marks the channel stale when what it removed takes a rebuild
+template <typename T>
+bool theia::Hermes::Channel_<T>::erase(Hermes &hermes, const ID id) {
+    bool erased = false;
+    if (const auto it = std::ranges::find(batch_ids, id); it != batch_ids.end()) {
+        const auto i = it - batch_ids.begin();
+        hermes.retire_(std::move(batch_receivers[i]));
+        batch_receivers.erase(batch_receivers.begin() + i);
+        batch_ids.erase(it);
+        hermes.mark_stale_(*this);
+        erased = true;
+    }
+    if (const auto it = std::ranges::find(async_ids, id); it != async_ids.end()) {
+        const auto i = it - async_ids.begin();
+        async_receivers[i]->live.store(false, std::memory_order_release);
+        async_receivers.erase(async_receivers.begin() + i);
+        async_pools.erase(async_pools.begin() + i);
+        async_ids.erase(it);
+        hermes.mark_stale_(*this);
+        erased = true;
+    }
+    if (!holds(id)) return erased;
+
+    const auto slot = slots[id];
+    auto &node = *nodes[slot];
+    if (slot != ids.size() - 1) {
+        ids[slot] = ids.back();
+        nodes[slot] = nodes.back();
+        slots[ids[slot]] = slot;
+    }
+    ids.pop_back();
+    nodes.pop_back();
+    slots[id] = NO_SLOT;
+    bury(hermes, node);
+    return true;
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::rebuild(Hermes &hermes) {
+    auto next = std::make_unique<Snapshot>();
+
+    for (auto *node : nodes) {
+        if constexpr (HasHermesKey<T>) {
+            if (node->key) {
+                next->keyed[*node->key].items.push_back(node);
+                continue;
+            }
+        }
+        if constexpr (HasHermesSource<T>) {
+            if (node->source) {
+                next->scoped[node->source].items.push_back(node);
+                continue;
+            }
+        }
+        next->receivers.items.push_back(node);
+    }
+    next->receivers.seal();
+    for (auto &[source, group] : next->scoped)
+        group.seal();
+    for (auto &[key, group] : next->keyed)
+        group.seal();
+
+    next->capture = capture;
+    if (capture && holds(*capture)) next->captured = nodes[slots[*capture]];
+
+    next->batch_ids = batch_ids;
+    for (const auto &receiver : batch_receivers)
+        next->batch_receivers.push_back(receiver.get());
+    next->async_ids = async_ids;
+    next->async_receivers = async_receivers;
+    next->async_pools = async_pools;
+
+    next->category_listeners = category_listeners;
+
+    if (next->capture) next->features |= Snapshot::CAPTURE;
+    if (!next->scoped.empty()) next->features |= Snapshot::SCOPED;
+    if (!next->keyed.empty()) next->features |= Snapshot::KEYED;
+    if (!next->batch_ids.empty()) next->features |= Snapshot::BATCH;
+    if (!next->async_ids.empty()) next->features |= Snapshot::ASYNC;
+    if (!next->category_listeners.empty()) next->features |= Snapshot::CATEGORY;
+    if (delivery == Delivery::Deferred) next->features |= Snapshot::DEFERRED;
+
+    snapshot.store(next.get(), std::memory_order_release);
+    if (current) hermes.retire_(std::move(current));
+    current = std::move(next);
+
+    // Nothing lists them any more once dispatch is past the snapshot just retired
+    for (auto *node : buried)
+        arena.release(hermes, *node);
+    buried.clear();
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::enqueue(T &&payload) {
+    constexpr auto policy = coalesce_policy_<T>();
+    if constexpr (policy != Coalesce::None) {
+        // With coalescing the queue holds at most one payload per source, so this scan stays short
+        for (auto &queued : queue) {
+            if constexpr (HasHermesSource<T>) {
+                if (queued.hermes_source() != payload.hermes_source()) continue;
+            }
+
+            if constexpr (policy == Coalesce::LatestWins) {
+                queued = std::move(payload);
+            } else {
+                queued.accumulate(payload);
+            }
+            return;
+        }
+    }
+    queue.push_back(std::move(payload));
+}
+
+template <typename T>
+bool theia::Hermes::Channel_<T>::matches(const Node_<T> &node, const T &payload) {
+    if constexpr (HasHermesSource<T>) {
+        if (node.source && node.source != payload.hermes_source()) return false;
+    }
+    if constexpr (HasHermesKey<T>) {
+        if (node.key && *node.key != payload.hermes_key()) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::dispatch(T *payload) {
+    // Receivers may change the lists as they run; that only replaces `snapshot`, while this one stays intact until the
+    // next quiescent point
+    const auto &view = read();
+    if (view.capture) {
+        if (view.captured && matches(*view.captured, *payload)) invoke(*view.captured, payload);
+        return;
+    }
+
+    for (auto *node : view.receivers.entries())
+        invoke(*node, payload);
+
+    if constexpr (HasHermesSource<T>) {
+        if (view.features & Snapshot::SCOPED) {
+            if (const auto it = view.scoped.find(payload->hermes_source()); it != view.scoped.end())
+                for (auto *node : it->second.entries())
+                    invoke(*node, payload);
+        }
+    }
+    if constexpr (HasHermesKey<T>) {
+        if (view.features & Snapshot::KEYED) {
+            if (const auto it = view.keyed.find(payload->hermes_key()); it != view.keyed.end())
+                for (auto *node : it->second.entries())
+                    invoke(*node, payload);
+        }
+    }
+
+    for (auto *listener : view.category_listeners)
+        if (listener->live.load(std::memory_order_acquire)) listener->receiver(EventView{T::HERMES_ID, payload});
+    if (waiters) resume_waiters(payload);
+}
+
+template <typename T>
+theia::Completion theia::Hermes::Channel_<T>::dispatch_async(T &&payload) {
+    const auto &view = read();
+    std::size_t count = 0;
+    for (const auto id : view.async_ids)
+        if (!view.capture || *view.capture == id) ++count;
+    if (count == 0) return {};
+
+    auto completion = Completion(count);
+    const auto shared = std::make_shared<const T>(std::move(payload));
+    for (std::size_t i = 0; i < view.async_ids.size(); ++i) {
+        if (view.capture && *view.capture != view.async_ids[i]) continue;
+
+        view.async_pools[i]->submit(
+            [payload = shared, receiver = view.async_receivers[i], remaining = completion.remaining_] {
+                if (receiver->live.load(std::memory_order_acquire)) receiver->receiver(*payload);
+                if (remaining->fetch_sub(1, std::memory_order_acq_rel) == 1) remaining->notify_all();
+            });
+    }
+    return completion;
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::invoke(Node_<T> &node, T *payload) {
+    if (!node.live.load(std::memory_order_acquire)) return;
+#if defined(THEIA_HERMES_STATS)
+    const auto start = std::chrono::steady_clock::now();
+    node.receiver(payload);
+    node.stats.record(std::chrono::steady_clock::now() - start);
+#else
+    node.receiver(payload);
+#endif
+}
+
+// For the owning thread. Announcing itself in `sticky_owned` before checking for visitors, while a visitor announces
+// itself before checking `sticky_owned`, means at least one of the two sees the other; the owner then takes the lock,
+// or the visitor waits for the owner to finish. Without visitors, publishing a sticky payload costs no lock.
+template <typename T>
+template <typename F>
+void theia::Hermes::Channel_<T>::own_sticky(F &&f) {
+    sticky_owned.store(true, std::memory_order_seq_cst);
+    if (sticky_visitors.load(std::memory_order_seq_cst) != 0) {
+        sticky_owned.store(false, std::memory_order_release);
+        std::scoped_lock lock(sticky_mutex);
+        f(sticky);
+        return;
+    }
+
+    struct Release {
+        std::atomic<bool> &owned;
+        ~Release() { owned.store(false, std::memory_order_release); }
+    } release{sticky_owned};
+    f(sticky);
+}
+
+// For any other thread; only waits for the owning thread while it is inside own_sticky()
+template <typename T>
+template <typename F>
+void theia::Hermes::Channel_<T>::visit_sticky(F &&f) {
+    sticky_visitors.fetch_add(1, std::memory_order_seq_cst);
+    struct Leave {
+        std::atomic<std::size_t> &visitors;
+        ~Leave() { visitors.fetch_sub(1, std::memory_order_release); }
+    } leave{sticky_visitors};
+    while (sticky_owned.load(std::memory_order_seq_cst))
+        std::this_thread::yield();
+
+    std::scoped_lock lock(sticky_mutex);
+    f(sticky);
+}
+
+template <typename T>
+template <typename F>
+void theia::Hermes::Channel_<T>::access_sticky(const Hermes &hermes, F &&f) {
+    if (hermes.is_owner_())
+        own_sticky(std::forward<F>(f));
+    else
+        visit_sticky(std::forward<F>(f));
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::remember(const T &payload) {
+    static_assert(std::copyable<T>, "HERMES_STICKY requires a copyable event type");
+
+    // One entry per source, so this scan stays short; the entry is rotated to the back to keep latest() a single load
+    own_sticky([&](std::vector<T> &latest) {
+        for (std::size_t i = 0; i < latest.size(); ++i) {
+            if constexpr (HasHermesSource<T>) {
+                if (latest[i].hermes_source() != payload.hermes_source()) continue;
+            }
+            std::rotate(latest.begin() + i, latest.begin() + i + 1, latest.end());
+            latest.back() = payload;
+            return;
+        }
+        latest.push_back(payload);
+    });
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::replay(Hermes &hermes, const ID id, Node_<T> &node) {
+    // The caller counted this replay in replaying_ before unlocking, so `node` and the snapshots read here outlive the
+    // loop even if they are retired meanwhile; `live` and the capture say whether the receiver still wants payloads
+    struct Finish {
+        Hermes &hermes;
+
+        ~Finish() {
+            const auto guard = MutationGuard_(hermes);
+            --hermes.replaying_;
+        }
+    } finish{hermes};
+
+    // Receivers get copies, so they can't change what later subscribers see, and a receiver that publishes T can't
+    // replace the payload under its own feet
+    std::vector<T> payloads{};
+    access_sticky(hermes, [&](const std::vector<T> &latest) { payloads = latest; });
+
+    for (auto &payload : payloads) {
+        const auto &view = read();
+        if (!node.live.load(std::memory_order_acquire) || (view.capture && *view.capture != id)) break;
+        if (matches(node, payload)) invoke(node, &payload);
+    }
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::forget([[maybe_unused]] const void *source) {
+    if constexpr (IsHermesSticky<T> and HasHermesSource<T>) {
+        own_sticky([&](std::vector<T> &latest) {
+            std::erase_if(latest, [&](const T &payload) { return payload.hermes_source() == source; });
+        });
+    }
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::resume_waiters(T *payload) {
+    // Move the list onto this frame first, so a coroutine that waits again right away is parked for the next payload
+    // rather than being handed this one a second time
+    Waiter_<T> *pending = waiters;
+    waiters = nullptr;
+    pending->prev_next = &pending;
+
+    // A resumed coroutine that throws leaves the rest of the list pointing into this frame, so hand it back first
+    struct Restore {
+        Waiter_<T> *&pending;
+        Waiter_<T> *&waiters;
+
+        ~Restore() {
+            while (auto *waiter = pending) {
+                waiter->unlink();
+                waiter->link(waiters);
+            }
+        }
+    } restore{pending, waiters};
+
+    while (pending) {
+        auto *waiter = pending;
+        waiter->unlink();
+        if (!waiter->accepts(waiter, *payload)) {
+            waiter->link(waiters);
+            continue;
+        }
+
+        waiter->payload = payload;
+        waiter->handle.resume();
+    }
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::pump(Hermes &hermes) {
+    if constexpr (std::move_constructible<T>) {
+        mailbox->consume([&](T &&payload) {
+            hermes.tap_payload_(payload);
+            hermes.deliver_(*this, payload);
+        });
+    }
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::stage() {
+    if constexpr (std::move_constructible<T>) std::swap(queue, draining);
+    if constexpr (std::copy_constructible<T>) std::swap(batch, flushing);
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::drain() {
+    if constexpr (std::move_constructible<T>) {
+        for (auto &payload : draining) {
+            if constexpr (IsHermesSticky<T>) remember(payload);
+            dispatch(&payload);
+            if (!read().async_receivers.empty()) dispatch_async(std::move(payload));
+        }
+        draining.clear();
+    }
+
+    if constexpr (std::copy_constructible<T>) {
+        if (flushing.empty()) return;
+
+        const auto events = std::span<const T>(flushing);
+        const auto &view = read();
+        for (std::size_t i = 0; i < view.batch_ids.size(); ++i) {
+            auto &held = *view.batch_receivers[i];
+            if ((!view.capture || *view.capture == view.batch_ids[i]) && held.live.load(std::memory_order_acquire))
+                held.receiver(events);
+        }
+        flushing.clear();
+    }
+}
+
+#if defined(THEIA_HERMES_STATS)
+template <typename T>
+void theia::Hermes::Channel_<T>::collect_stats(EventStats &entry) const {
+    entry.handlers.reserve(ids.size());
+    for (std::size_t slot = 0; slot < ids.size(); ++slot)
+        entry.handlers.emplace_back(ids[slot], nodes[slot]->stats);
+}
+
+template <typename T>
+void theia::Hermes::Channel_<T>::reset_stats() {
+    for (auto *node : nodes)
+        node->stats = HandlerStats{};
+}
+#endif
+
+inline theia::Completion::Completion(const std::size_t count)
+    : remaining_(std::make_shared<std::atomic<std::size_t>>(count)) {}
+
+inline bool theia::Completion::done() const {
+    return !remaining_ || remaining_->load(std::memory_order_acquire) == 0;
+}
+
+inline void theia::Completion::wait() const {
+    if (!remaining_) return;
+    for (auto remaining = remaining_->load(std::memory_order_acquire); remaining != 0;
+         remaining = remaining_->load(std::memory_order_acquire))
+        remaining_->wait(remaining, std::memory_order_acquire);
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+bool theia::EventView::is() const {
+    return id == T::HERMES_ID;
+}
+
+template <typename T>
+    requires theia::HashHermesId<T>
+T *theia::EventView::as() const {
+    return is<T>() ? static_cast<T *>(payload) : nullptr;
 }
 
 namespace murmur::internal {
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace theia {
+// Bounded lock-free queue for many producer threads and a single consumer thread (Vyukov's sequence-numbered ring).
+// Producers never block: a full queue makes try_emplace() fail instead.
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(std::size_t capacity);
+    ~MpscQueue();
+
+    MpscQueue(const MpscQueue &other) = delete;
+    MpscQueue &operator=(const MpscQueue &other) = delete;
+
+    MpscQueue(MpscQueue &&other) = delete;
+    MpscQueue &operator=(MpscQueue &&other) = delete;
+
+    // Safe to call from any thread
+    template <typename... Args>
+    bool try_emplace(Args &&...args);
+
+    // Consumer thread only; hands every element visible at the time of the call to `f` and returns how many there were
+    template <typename Func>
+    std::size_t consume(Func &&f);
+
+    [[nodiscard]] std::size_t capacity() const;
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    struct Cell_ {
+        std::atomic<std::size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::unique_ptr<Cell_[]> cells_;
+    std::size_t mask_;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail_{0};
+    alignas(CACHE_LINE) std::size_t head_{0};
+};
+} // namespace theia
+
+template <typename T>
+theia::MpscQueue<T>::MpscQueue(const std::size_t capacity)
+    : cells_(std::make_unique<Cell_[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+      mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+    for (std::size_t i = 0; i <= mask_; ++i)
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+theia::MpscQueue<T>::~MpscQueue() {
+    consume([](T &&) {});
+}
+
+template <typename T>
+template <typename... Args>
+bool theia::MpscQueue<T>::try_emplace(Args &&...args) {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    Cell_ *cell;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    ::new (static_cast<void *>(cell->storage)) T{std::forward<Args>(args)...};
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+template <typename Func>
+std::size_t theia::MpscQueue<T>::consume(Func &&f) {
+    const auto start = head_;
+    const auto end = tail_.load(std::memory_order_relaxed);
+    while (head_ != end) {
+        auto &cell = cells_[head_ & mask_];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(head_ + 1) < 0) break;
+
+        auto *value = std::launder(reinterpret_cast<T *>(cell.storage));
+        f(std::move(*value));
+        value->~T();
+
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+    }
+    return head_ - start;
+}
+
+template <typename T>
+std::size_t theia::MpscQueue<T>::capacity() const {
+    return mask_ + 1;
+}
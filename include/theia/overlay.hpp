@@ -7,5 +7,5 @@ struct OverlayTabEvent {
     MAKE_HERMES_ID(theia::OverlayTabEvent);
 };
 
-void draw_overlay();
+void draw_overlay(Hermes &hermes = Hermes::instance());
 } // namespace theia
@@ -0,0 +1,301 @@
+#pragma once
+
+// Header-only on purpose: external inspectors include this without linking theia (and with it ImGui and GLFW).
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "theia/shm_ring.hpp needs POSIX shared memory (shm_open and mmap)"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace theia::shm {
+constexpr std::uint32_t MAGIC = 0x534d5248; // "HRMS"
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t MAX_TYPES = 64;
+constexpr std::size_t NAME_SIZE = 48;
+constexpr std::size_t CACHE_LINE = 64;
+
+// Fills the space between the last record and the end of the ring when the next one would not fit
+constexpr std::uint32_t PAD_ID = 0;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "The ring needs address-free 64-bit atomics");
+
+struct TypeEntry {
+    std::uint32_t id;
+    std::uint32_t size;
+    std::atomic<std::uint64_t> count; // Every payload of this type written, including those later overwritten
+    char name[NAME_SIZE];
+};
+
+struct RecordHeader {
+    std::uint32_t id;
+    std::uint32_t size;
+    std::int64_t timestamp_ns;
+};
+
+// Start of the shared memory object; the ring data follows at DATA_OFFSET. `reserved` runs ahead of `head` while a
+// record is being written, so a reader can tell afterwards whether what it copied was overwritten under it.
+struct Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t capacity;
+    std::atomic<std::uint32_t> type_count;
+    TypeEntry types[MAX_TYPES];
+
+    alignas(CACHE_LINE) std::atomic<std::uint64_t> reserved;
+    alignas(CACHE_LINE) std::atomic<std::uint64_t> head;
+    std::atomic<std::uint64_t> oversized; // Records dropped because they were larger than the whole ring
+};
+
+constexpr std::size_t DATA_OFFSET = (sizeof(Header) + CACHE_LINE - 1) & ~(CACHE_LINE - 1);
+
+constexpr std::size_t padded(const std::size_t size) { return (size + 7) & ~std::size_t{7}; }
+
+// Single producer. Never waits on readers: once the ring is full the oldest records are overwritten, and readers that
+// fell behind notice and skip ahead.
+class RingWriter {
+public:
+    RingWriter(const std::string &name, std::size_t capacity);
+    ~RingWriter();
+
+    RingWriter(const RingWriter &other) = delete;
+    RingWriter &operator=(const RingWriter &other) = delete;
+
+    RingWriter(RingWriter &&other) = delete;
+    RingWriter &operator=(RingWriter &&other) = delete;
+
+    // Returns the slot to pass to write(), or MAX_TYPES once the type table is full
+    std::size_t add_type(std::uint32_t id, std::uint32_t size, std::string_view name);
+
+    void write(std::size_t slot, std::chrono::nanoseconds timestamp, std::span<const std::byte> payload);
+
+private:
+    std::string name_;
+    Header *header_{nullptr};
+    std::byte *data_{nullptr};
+    std::size_t size_{0};
+    std::uint64_t head_{0};
+};
+
+// Read-only observer; any number of them can follow the same ring
+class RingReader {
+public:
+    explicit RingReader(const std::string &name);
+    ~RingReader();
+
+    RingReader(const RingReader &other) = delete;
+    RingReader &operator=(const RingReader &other) = delete;
+
+    RingReader(RingReader &&other) = delete;
+    RingReader &operator=(RingReader &&other) = delete;
+
+    // Hands every record committed since the previous call to f(const RecordHeader &, std::span<const std::byte>).
+    // The first call starts from whatever is newest. Returns false if records were lost because the writer lapped us.
+    template <typename Func>
+    bool poll(Func &&f);
+
+    [[nodiscard]] std::span<const TypeEntry> types() const;
+    [[nodiscard]] const Header &header() const;
+
+private:
+    Header *header_{nullptr};
+    const std::byte *data_{nullptr};
+    std::size_t size_{0};
+    std::uint64_t position_{0};
+    std::vector<std::byte> scratch_{};
+};
+} // namespace theia::shm
+
+inline theia::shm::RingWriter::RingWriter(const std::string &name, std::size_t capacity)
+    : name_(name) {
+    capacity = std::bit_ceil(std::max<std::size_t>(capacity, 4096));
+    size_ = DATA_OFFSET + capacity;
+
+    const int fd = ::shm_open(name_.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create shared memory '" + name_ + "'");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Failed to size shared memory '" + name_ + "'");
+    }
+
+    void *mapping = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Failed to map shared memory '" + name_ + "'");
+    }
+
+    header_ = ::new (mapping) Header{};
+    header_->version = VERSION;
+    header_->capacity = capacity;
+    data_ = static_cast<std::byte *>(mapping) + DATA_OFFSET;
+
+    // Readers only trust the header once the magic is there
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = MAGIC;
+}
+
+inline theia::shm::RingWriter::~RingWriter() {
+    ::munmap(header_, size_);
+    ::shm_unlink(name_.c_str());
+}
+
+inline std::size_t theia::shm::RingWriter::add_type(const std::uint32_t id,
+                                                    const std::uint32_t size,
+                                                    const std::string_view name) {
+    const auto slot = header_->type_count.load(std::memory_order_relaxed);
+    if (slot >= MAX_TYPES) return MAX_TYPES;
+
+    auto &entry = header_->types[slot];
+    entry.id = id;
+    entry.size = size;
+    const auto length = std::min(name.size(), NAME_SIZE - 1);
+    std::memcpy(entry.name, name.data(), length);
+    entry.name[length] = '\0';
+
+    header_->type_count.store(slot + 1, std::memory_order_release);
+    return slot;
+}
+
+inline void theia::shm::RingWriter::write(const std::size_t slot,
+                                          const std::chrono::nanoseconds timestamp,
+                                          const std::span<const std::byte> payload) {
+    auto &entry = header_->types[slot];
+    entry.count.fetch_add(1, std::memory_order_relaxed);
+
+    const auto capacity = header_->capacity;
+    const auto record_size = sizeof(RecordHeader) + padded(payload.size());
+    if (record_size > capacity) {
+        header_->oversized.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto offset = head_ & (capacity - 1);
+    const auto wrap = capacity - offset < record_size ? capacity - offset : 0;
+
+    header_->reserved.store(head_ + wrap + record_size, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (wrap) {
+        if (wrap >= sizeof(RecordHeader)) {
+            const auto pad = RecordHeader{PAD_ID, static_cast<std::uint32_t>(wrap - sizeof(RecordHeader)), 0};
+            std::memcpy(data_ + offset, &pad, sizeof(pad));
+        }
+        head_ += wrap;
+        offset = 0;
+    }
+
+    const auto record = RecordHeader{entry.id, static_cast<std::uint32_t>(payload.size()), timestamp.count()};
+    std::memcpy(data_ + offset, &record, sizeof(record));
+    std::memcpy(data_ + offset + sizeof(record), payload.data(), payload.size());
+    head_ += record_size;
+
+    header_->head.store(head_, std::memory_order_release);
+}
+
+inline theia::shm::RingReader::RingReader(const std::string &name) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("No shared memory named '" + name + "'");
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < DATA_OFFSET) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory '" + name + "' is not a Hermes ring");
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map shared memory '" + name + "'");
+    }
+
+    header_ = static_cast<Header *>(mapping);
+    data_ = static_cast<const std::byte *>(mapping) + DATA_OFFSET;
+
+    const auto magic = header_->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (magic != MAGIC || header_->version != VERSION || DATA_OFFSET + header_->capacity != size_) {
+        ::munmap(mapping, size_);
+        throw std::runtime_error("Shared memory '" + name + "' is not a compatible Hermes ring");
+    }
+
+    position_ = header_->head.load(std::memory_order_acquire);
+}
+
+inline theia::shm::RingReader::~RingReader() { ::munmap(header_, size_); }
+
+template <typename Func>
+bool theia::shm::RingReader::poll(Func &&f) {
+    const auto capacity = header_->capacity;
+    const auto head = header_->head.load(std::memory_order_acquire);
+
+    // Anything the writer has reserved past one lap ahead of us is gone
+    const auto lapped = [&] {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return header_->reserved.load(std::memory_order_relaxed) - position_ > capacity;
+    };
+
+    while (position_ != head) {
+        const auto offset = position_ & (capacity - 1);
+        const auto remaining = capacity - offset;
+        if (remaining < sizeof(RecordHeader)) {
+            position_ += remaining;
+            continue;
+        }
+
+        RecordHeader record;
+        std::memcpy(&record, data_ + offset, sizeof(record));
+
+        const auto payload_size = record.id == PAD_ID ? 0 : record.size;
+        if (sizeof(record) + payload_size > remaining) {
+            position_ = header_->head.load(std::memory_order_acquire);
+            return false;
+        }
+        scratch_.resize(payload_size);
+        std::memcpy(scratch_.data(), data_ + offset + sizeof(record), payload_size);
+
+        if (lapped()) {
+            position_ = header_->head.load(std::memory_order_acquire);
+            return false;
+        }
+
+        if (record.id == PAD_ID) {
+            position_ += remaining;
+            continue;
+        }
+
+        f(record, std::span<const std::byte>(scratch_));
+        position_ += sizeof(record) + padded(record.size);
+    }
+    return true;
+}
+
+inline std::span<const theia::shm::TypeEntry> theia::shm::RingReader::types() const {
+    const auto count = std::min<std::size_t>(header_->type_count.load(std::memory_order_acquire), MAX_TYPES);
+    return {header_->types, count};
+}
+
+inline const theia::shm::Header &theia::shm::RingReader::header() const { return *header_; }
@@ -0,0 +1,54 @@
+#pragma once
+
+#if !defined(THEIA_HAS_SHM_SINK)
+#error "theia::ShmSink is only built on POSIX systems"
+#endif
+
+#include "theia/hermes.hpp"
+#include "theia/shm_ring.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace theia {
+// Mirrors selected event types into a shared memory ring (see theia/shm_ring.hpp) for an inspector in another process,
+// e.g. tools/hermes_inspect. Publishing never waits on the reader; if it falls behind it loses records, not the app.
+class ShmSink {
+public:
+    explicit ShmSink(const std::string &name, std::size_t capacity = 1 << 20, Hermes &hermes = Hermes::instance());
+    ~ShmSink();
+
+    ShmSink(const ShmSink &other) = delete;
+    ShmSink &operator=(const ShmSink &other) = delete;
+
+    ShmSink(ShmSink &&other) = delete;
+    ShmSink &operator=(ShmSink &&other) = delete;
+
+    template <typename T>
+        requires HashHermesId<T> and std::is_trivially_copyable_v<T>
+    void watch();
+
+private:
+    Hermes &hermes_;
+    shm::RingWriter ring_;
+    std::chrono::steady_clock::time_point start_;
+    Hermes::TapID tap_{};
+
+    std::vector<std::uint32_t> ids_{}; // Indexed by ring type slot
+
+    void watch_(std::uint32_t id, std::uint32_t size, std::string_view name);
+};
+} // namespace theia
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::is_trivially_copyable_v<T>
+void theia::ShmSink::watch() {
+    if constexpr (requires { T::HERMES_NAME; }) {
+        watch_(T::HERMES_ID, sizeof(T), T::HERMES_NAME);
+    } else {
+        watch_(T::HERMES_ID, sizeof(T), {});
+    }
+}
@@ -0,0 +1,318 @@
+#pragma once
+
+#include "theia/delegate.hpp"
+#include "theia/hermes.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace theia {
+template <typename T, typename... Events>
+concept OneOfEvents = (std::same_as<T, Events> or ...);
+
+template <typename Handler, typename... Events>
+concept HandlesOneOf = (std::invocable<Handler &, Events *> or ...);
+
+// Event bus over a set of event types fixed at compile time, for hot loops that don't need the rest of Hermes. Each
+// type's receivers live in their own table of a tuple, so publishing is a loop over one array: no type registry, no
+// channel lookup, and no taps, capture, deferred delivery or mailboxes. Not thread-safe, but receivers may subscribe
+// and unsubscribe: while publish() runs, a new receiver waits until the outermost publish() returns, and a removed one
+// is skipped right away and destroyed once that publish() is over.
+//
+// Receivers subscribed at runtime are Delegates, so each one is an indirect call. Handlers known up front can be fixed
+// in the bus type instead with with(); see With.
+template <typename... Events>
+    requires(HashHermesId<Events> and ...)
+class StaticHermes {
+    static_assert(unique_hermes_ids<Events...>(), "Hermes IDs of the StaticHermes event types collide");
+
+    template <typename T>
+    using Receiver = Delegate<void(T *)>;
+
+public:
+    using ID = std::size_t;
+
+    StaticHermes() = default;
+    ~StaticHermes() = default;
+
+    StaticHermes(const StaticHermes &other) = delete;
+    StaticHermes &operator=(const StaticHermes &other) = delete;
+
+    StaticHermes(StaticHermes &&other) = delete;
+    StaticHermes &operator=(StaticHermes &&other) = delete;
+
+    template <typename T, typename Func>
+        requires OneOfEvents<T, Events...> and std::invocable<Func, T *>
+    ID subscribe(Func &&f);
+
+    template <typename T>
+        requires OneOfEvents<T, Events...>
+    void unsubscribe(ID id);
+
+    template <typename T, typename... Args>
+        requires OneOfEvents<T, Events...>
+    void publish(Args &&...args);
+
+    template <typename... Handlers>
+        requires(HandlesOneOf<Handlers, Events...> and ...)
+    class With;
+
+    // e.g. auto bus = StaticHermes<KeyEvent, CharEvent>::with([](KeyEvent *e) { ... }, [](CharEvent *e) { ... });
+    template <typename... Handlers>
+        requires(HandlesOneOf<std::decay_t<Handlers>, Events...> and ...)
+    static With<std::decay_t<Handlers>...> with(Handlers &&...handlers);
+
+private:
+    // Dense like Hermes' channels: `slots` maps an ID to its position in `ids`/`receivers`
+    template <typename T>
+    struct Table_ {
+        static constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+
+        std::vector<Receiver<T>> receivers{};
+        std::vector<ID> ids{};
+        std::vector<std::size_t> slots{};
+
+        // Changes made while publishing, applied by settle(). A removed receiver stays in place with its slot cleared,
+        // so publish() can tell it apart without the vectors moving under it.
+        std::vector<std::pair<ID, Receiver<T>>> added{};
+        std::vector<std::size_t> removed{};
+
+        bool live(std::size_t slot) const;
+        void link(ID id, Receiver<T> &&receiver);
+        void settle();
+    };
+
+    struct PublishGuard_ {
+        StaticHermes &hermes;
+
+        explicit PublishGuard_(StaticHermes &hermes);
+        ~PublishGuard_();
+    };
+
+    std::tuple<Table_<Events>...> tables_{};
+
+    ID next_id_{0};
+    std::vector<ID> recycled_ids_{};
+
+    std::size_t publishing_{0};
+    bool has_pending_{false};
+    std::vector<ID> released_ids_{}; // Only recycled once the receivers using them are gone
+
+    // Runs the subscribed receivers; the caller holds a PublishGuard_
+    template <typename T>
+    void dispatch_(T &payload);
+
+    ID acquire_id_();
+    void settle_();
+};
+
+// A StaticHermes whose handlers are part of its type. publish<T>() calls each handler that takes a T * directly, in the
+// order they were given and before any receiver subscribed at runtime, so the compiler sees every call and can inline
+// it. The handlers can't be removed; subscribe() and unsubscribe() still manage runtime receivers as usual. The base is
+// private, so a With can't be used as a plain StaticHermes whose publish() would skip the handlers.
+template <typename... Events>
+    requires(HashHermesId<Events> and ...)
+template <typename... Handlers>
+    requires(HandlesOneOf<Handlers, Events...> and ...)
+class StaticHermes<Events...>::With : private StaticHermes<Events...> {
+public:
+    using typename StaticHermes::ID;
+
+    explicit With(Handlers... handlers);
+
+    using StaticHermes::subscribe;
+    using StaticHermes::unsubscribe;
+
+    template <typename T, typename... Args>
+        requires OneOfEvents<T, Events...>
+    void publish(Args &&...args);
+
+private:
+    std::tuple<Handlers...> handlers_;
+};
+} // namespace theia
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T, typename Func>
+    requires theia::OneOfEvents<T, Events...> and std::invocable<Func, T *>
+theia::StaticHermes<Events...>::ID theia::StaticHermes<Events...>::subscribe(Func &&f) {
+    const auto id = acquire_id_();
+    auto &table = std::get<Table_<T>>(tables_);
+    if (publishing_ > 0) {
+        table.added.emplace_back(id, Receiver<T>(std::forward<Func>(f)));
+        has_pending_ = true;
+    } else {
+        table.link(id, Receiver<T>(std::forward<Func>(f)));
+    }
+    return id;
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T>
+    requires theia::OneOfEvents<T, Events...>
+void theia::StaticHermes<Events...>::unsubscribe(const ID id) {
+    auto &table = std::get<Table_<T>>(tables_);
+    if (publishing_ > 0) {
+        if (const auto it = std::ranges::find(table.added, id, &std::pair<ID, Receiver<T>>::first);
+            it != table.added.end()) {
+            table.added.erase(it);
+        } else if (table.slots.size() > id && table.slots[id] != Table_<T>::NO_SLOT) {
+            table.removed.push_back(std::exchange(table.slots[id], Table_<T>::NO_SLOT));
+        } else {
+            return;
+        }
+        released_ids_.push_back(id);
+        has_pending_ = true;
+        return;
+    }
+
+    if (table.slots.size() <= id || table.slots[id] == Table_<T>::NO_SLOT) return;
+
+    const auto slot = table.slots[id];
+    if (slot != table.ids.size() - 1) {
+        table.ids[slot] = table.ids.back();
+        table.receivers[slot] = std::move(table.receivers.back());
+        table.slots[table.ids[slot]] = slot;
+    }
+    table.ids.pop_back();
+    table.receivers.pop_back();
+    table.slots[id] = Table_<T>::NO_SLOT;
+    recycled_ids_.push_back(id);
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T, typename... Args>
+    requires theia::OneOfEvents<T, Events...>
+void theia::StaticHermes<Events...>::publish(Args &&...args) {
+    T payload{std::forward<Args>(args)...};
+
+    const auto guard = PublishGuard_(*this);
+    dispatch_(payload);
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename... Handlers>
+    requires(theia::HandlesOneOf<std::decay_t<Handlers>, Events...> and ...)
+theia::StaticHermes<Events...>::With<std::decay_t<Handlers>...>
+theia::StaticHermes<Events...>::with(Handlers &&...handlers) {
+    return With<std::decay_t<Handlers>...>(std::forward<Handlers>(handlers)...);
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T>
+void theia::StaticHermes<Events...>::dispatch_(T &payload) {
+    auto &table = std::get<Table_<T>>(tables_);
+    for (std::size_t i = 0; i < table.receivers.size(); ++i)
+        if (table.removed.empty() || table.live(i)) table.receivers[i](&payload);
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+theia::StaticHermes<Events...>::ID theia::StaticHermes<Events...>::acquire_id_() {
+    if (recycled_ids_.empty()) return next_id_++;
+
+    const auto id = recycled_ids_.back();
+    recycled_ids_.pop_back();
+    return id;
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+void theia::StaticHermes<Events...>::settle_() {
+    has_pending_ = false;
+    std::apply([](auto &...tables) { (tables.settle(), ...); }, tables_);
+    recycled_ids_.insert(recycled_ids_.end(), released_ids_.begin(), released_ids_.end());
+    released_ids_.clear();
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+theia::StaticHermes<Events...>::PublishGuard_::PublishGuard_(StaticHermes &hermes)
+    : hermes(hermes) {
+    ++hermes.publishing_;
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+theia::StaticHermes<Events...>::PublishGuard_::~PublishGuard_() {
+    if (--hermes.publishing_ == 0 && hermes.has_pending_) hermes.settle_();
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T>
+bool theia::StaticHermes<Events...>::Table_<T>::live(const std::size_t slot) const {
+    return slots[ids[slot]] == slot;
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T>
+void theia::StaticHermes<Events...>::Table_<T>::link(const ID id, Receiver<T> &&receiver) {
+    if (slots.size() <= id) slots.resize(id + 1, NO_SLOT);
+    slots[id] = ids.size();
+    ids.push_back(id);
+    receivers.push_back(std::move(receiver));
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename T>
+void theia::StaticHermes<Events...>::Table_<T>::settle() {
+    // Highest slot first, so the entry swapped into a freed slot is never one still waiting to be removed
+    std::ranges::sort(removed, std::greater{});
+    for (const auto slot : removed) {
+        if (slot != ids.size() - 1) {
+            ids[slot] = ids.back();
+            receivers[slot] = std::move(receivers.back());
+            slots[ids[slot]] = slot;
+        }
+        ids.pop_back();
+        receivers.pop_back();
+    }
+    removed.clear();
+
+    for (auto &[id, receiver] : added)
+        link(id, std::move(receiver));
+    added.clear();
+}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename... Handlers>
+    requires(theia::HandlesOneOf<Handlers, Events...> and ...)
+theia::StaticHermes<Events...>::With<Handlers...>::With(Handlers... handlers)
+    : handlers_(std::move(handlers)...) {}
+
+template <typename... Events>
+    requires(theia::HashHermesId<Events> and ...)
+template <typename... Handlers>
+    requires(theia::HandlesOneOf<Handlers, Events...> and ...)
+template <typename T, typename... Args>
+    requires theia::OneOfEvents<T, Events...>
+void theia::StaticHermes<Events...>::With<Handlers...>::publish(Args &&...args) {
+    T payload{std::forward<Args>(args)...};
+
+    // Held across the fixed handlers too, so a receiver one of them subscribes waits like any other
+    const auto guard = typename StaticHermes::PublishGuard_(*this);
+    std::apply(
+        [&](Handlers &...handlers) {
+            const auto call = [&](auto &handler) {
+                if constexpr (std::invocable<decltype(handler), T *>) handler(&payload);
+            };
+            (call(handlers), ...);
+        },
+        handlers_);
+    this->dispatch_(payload);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <coroutine>
+#include <utility>
+
+namespace theia {
+// Coroutine that starts running as soon as it is called and owns its frame: destroying the Task cancels it wherever it
+// is suspended. Exceptions escape to whoever resumed it, the same as they would from a Hermes receiver.
+class Task {
+public:
+    struct promise_type {
+        Task get_return_object();
+        std::suspend_never initial_suspend() noexcept;
+        std::suspend_always final_suspend() noexcept;
+        void return_void();
+        void unhandled_exception();
+    };
+
+    Task() = default;
+    ~Task();
+
+    Task(const Task &other) = delete;
+    Task &operator=(const Task &other) = delete;
+
+    Task(Task &&other) noexcept;
+    Task &operator=(Task &&other) noexcept;
+
+    [[nodiscard]] bool done() const;
+
+private:
+    std::coroutine_handle<promise_type> handle_{};
+
+    explicit Task(std::coroutine_handle<promise_type> handle);
+};
+} // namespace theia
+
+inline theia::Task theia::Task::promise_type::get_return_object() {
+    return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+inline std::suspend_never theia::Task::promise_type::initial_suspend() noexcept { return {}; }
+
+inline std::suspend_always theia::Task::promise_type::final_suspend() noexcept { return {}; }
+
+inline void theia::Task::promise_type::return_void() {}
+
+inline void theia::Task::promise_type::unhandled_exception() { throw; }
+
+inline theia::Task::Task(const std::coroutine_handle<promise_type> handle)
+    : handle_(handle) {}
+
+inline theia::Task::~Task() {
+    if (handle_) handle_.destroy();
+}
+
+inline theia::Task::Task(Task &&other) noexcept
+    : handle_(std::exchange(other.handle_, {})) {}
+
+inline theia::Task &theia::Task::operator=(Task &&other) noexcept {
+    if (this != &other) {
+        if (handle_) handle_.destroy();
+        handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+}
+
+inline bool theia::Task::done() const { return !handle_ || handle_.done(); }
@@ -1,9 +1,44 @@
 #pragma once
 
 #include "theia/dear.hpp"
+#include "theia/delegate.hpp"
 #include "theia/hermes.hpp"
 #include "theia/io.hpp"
 #include "theia/logger.hpp"
+#include "theia/mpsc_queue.hpp"
 #include "theia/overlay.hpp"
+#include "theia/static_hermes.hpp"
+#include "theia/task.hpp"
+#include "theia/worker_pool.hpp"
+
+#if defined(THEIA_HAS_SHM_SINK)
+#include "theia/shm_ring.hpp"
+#include "theia/shm_sink.hpp"
+#endif
+
+#if defined(THEIA_HAS_TRACE)
+#include "theia/trace.hpp"
+#endif
 
 #include "glfwpp/glfwpp.hpp"
+
+static_assert(theia::unique_hermes_ids<theia::OverlayTabEvent,
+                                       glfwpp::event::KeyEvent,
+                                       glfwpp::event::CharEvent,
+                                       glfwpp::event::CursorPosEvent,
+                                       glfwpp::event::CursorEnterEvent,
+                                       glfwpp::event::MouseButtonEvent,
+                                       glfwpp::event::ScrollEvent,
+                                       glfwpp::event::DropEvent,
+                                       glfwpp::event::JoystickEvent,
+                                       glfwpp::event::MonitorEvent,
+                                       glfwpp::event::WindowCloseEvent,
+                                       glfwpp::event::WindowSizeEvent,
+                                       glfwpp::event::FramebufferSizeEvent,
+                                       glfwpp::event::WindowContentScaleEvent,
+                                       glfwpp::event::WindowPosEvent,
+                                       glfwpp::event::WindowIconifyEvent,
+                                       glfwpp::event::WindowMaximizeEvent,
+                                       glfwpp::event::WindowFocusEvent,
+                                       glfwpp::event::WindowRefreshEvent>(),
+              "Hermes IDs of the built-in events collide");
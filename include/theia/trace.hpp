@@ -0,0 +1,135 @@
+#pragma once
+
+#if !defined(THEIA_HAS_TRACE)
+#error "theia's trace files are only built on POSIX systems"
+#endif
+
+#include "theia/hermes.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace theia {
+struct TraceRecord {
+    std::uint32_t id;
+    std::chrono::nanoseconds timestamp; // Since the start of the recording
+    std::span<const std::byte> payload;
+};
+
+// Appends records to a file through a memory mapping that grows geometrically
+class TraceWriter {
+public:
+    explicit TraceWriter(const std::filesystem::path &path);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter &other) = delete;
+    TraceWriter &operator=(const TraceWriter &other) = delete;
+
+    TraceWriter(TraceWriter &&other) = delete;
+    TraceWriter &operator=(TraceWriter &&other) = delete;
+
+    void append(std::uint32_t id, std::chrono::nanoseconds timestamp, std::span<const std::byte> payload);
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    int fd_{-1};
+    std::byte *data_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t size_{0};
+
+    void map_(std::size_t capacity);
+};
+
+class TraceReader {
+public:
+    explicit TraceReader(const std::filesystem::path &path);
+    ~TraceReader();
+
+    TraceReader(const TraceReader &other) = delete;
+    TraceReader &operator=(const TraceReader &other) = delete;
+
+    TraceReader(TraceReader &&other) = delete;
+    TraceReader &operator=(TraceReader &&other) = delete;
+
+    // The returned payload points into the mapping and stays valid for the lifetime of the reader
+    std::optional<TraceRecord> next();
+    void rewind();
+
+private:
+    std::byte *data_{nullptr};
+    std::size_t size_{0};
+    std::size_t offset_{0};
+};
+
+// Records the watched event types published on `hermes` for as long as it is alive
+class TraceRecorder {
+public:
+    explicit TraceRecorder(const std::filesystem::path &path, Hermes &hermes = Hermes::instance());
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder &other) = delete;
+    TraceRecorder &operator=(const TraceRecorder &other) = delete;
+
+    TraceRecorder(TraceRecorder &&other) = delete;
+    TraceRecorder &operator=(TraceRecorder &&other) = delete;
+
+    // Replay republishes a payload's bytes as they were, so watch types that still make sense then, such as input;
+    // not ones tied to the frame they were published in (e.g. OverlayTabEvent) or that describe session state
+    template <typename T>
+        requires HashHermesId<T> and std::is_trivially_copyable_v<T>
+    void watch();
+
+private:
+    Hermes &hermes_;
+    TraceWriter writer_;
+    std::chrono::steady_clock::time_point start_;
+    Hermes::TapID tap_{};
+
+    std::vector<std::uint32_t> ids_{};
+};
+
+enum class ReplaySpeed {
+    Original, // Records are published once as much time has passed as when they were recorded
+    Maximum,  // Every remaining record is published on the next pump()
+};
+
+// Payloads are replayed byte for byte, so handles inside them (e.g. glfwpp::WindowRef) still refer to the recording
+// session and must not be dereferenced by receivers driven from a trace.
+class TraceReplay {
+public:
+    explicit TraceReplay(const std::filesystem::path &path,
+                         ReplaySpeed speed = ReplaySpeed::Original,
+                         Hermes &hermes = Hermes::instance());
+
+    // Publishes every record that is due; returns false once the whole trace has been replayed
+    bool pump();
+
+    [[nodiscard]] bool finished() const;
+
+private:
+    Hermes &hermes_;
+    TraceReader reader_;
+    ReplaySpeed speed_;
+
+    std::optional<std::chrono::steady_clock::time_point> start_{};
+    std::optional<TraceRecord> next_{};
+    std::unordered_map<std::uint32_t, EventInfo> types_{};
+
+    void publish_(const TraceRecord &record);
+};
+} // namespace theia
+
+template <typename T>
+    requires theia::HashHermesId<T> and std::is_trivially_copyable_v<T>
+void theia::TraceRecorder::watch() {
+    if (std::ranges::find(ids_, T::HERMES_ID) == ids_.end()) ids_.push_back(T::HERMES_ID);
+}
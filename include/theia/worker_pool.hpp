@@ -0,0 +1,98 @@
+#pragma once
+
+#include "theia/delegate.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace theia {
+// Fixed set of threads running jobs in submission order, e.g. the async receivers of Hermes::subscribe_async()
+class WorkerPool {
+public:
+    using Job = Delegate<void()>;
+
+    explicit WorkerPool(std::size_t threads = std::thread::hardware_concurrency());
+
+    // Runs every job still queued before joining the threads
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &other) = delete;
+    WorkerPool &operator=(const WorkerPool &other) = delete;
+
+    WorkerPool(WorkerPool &&other) = delete;
+    WorkerPool &operator=(WorkerPool &&other) = delete;
+
+    // Shared by everything that is not given a pool of its own; started on first use
+    static WorkerPool &instance();
+
+    // Safe to call from any thread
+    void submit(Job job);
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    std::mutex mutex_{};
+    std::condition_variable ready_{};
+    std::deque<Job> jobs_{};
+    bool stopping_{false};
+
+    std::vector<std::thread> threads_{};
+
+    void run_();
+};
+} // namespace theia
+
+inline theia::WorkerPool::WorkerPool(const std::size_t threads) {
+    // hardware_concurrency() may report 0 when it can't tell
+    const auto count = std::max<std::size_t>(threads, 1);
+    threads_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        threads_.emplace_back([this] { run_(); });
+}
+
+inline theia::WorkerPool::~WorkerPool() {
+    {
+        std::scoped_lock lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+
+    for (auto &thread : threads_)
+        thread.join();
+}
+
+inline theia::WorkerPool &theia::WorkerPool::instance() {
+    static WorkerPool instance;
+    return instance;
+}
+
+inline void theia::WorkerPool::submit(Job job) {
+    {
+        std::scoped_lock lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    ready_.notify_one();
+}
+
+inline std::size_t theia::WorkerPool::size() const { return threads_.size(); }
+
+inline void theia::WorkerPool::run_() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) return;
+
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
@@ -5,7 +5,7 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
-glfwpp::Context::Context() {
+glfwpp::Context::Context(theia::Hermes &hermes) {
     glfwSetErrorCallback(
         [](int error, const char *description) { THEIA_LOG_ERROR("GLFW error {}: {}", error, description); });
 
@@ -15,7 +15,7 @@ glfwpp::Context::Context() {
 
     THEIA_LOG_DEBUG("GLFW v{}", glfwGetVersionString());
 
-    set_monitor_callbacks();
+    set_monitor_callbacks(hermes);
 }
 
 glfwpp::Context::~Context() { glfwTerminate(); }
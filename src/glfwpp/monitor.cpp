@@ -98,10 +98,19 @@ std::vector<glfwpp::Monitor> glfwpp::get_monitors() {
     return result;
 }
 
-void glfwpp::set_monitor_callbacks() {
+// GLFW's monitor callback carries no user data, so the bus it publishes to has to live here
+static theia::Hermes *monitor_hermes = nullptr;
+
+void glfwpp::set_monitor_callbacks(theia::Hermes &hermes) {
+    monitor_hermes = &hermes;
     glfwSetMonitorCallback([](GLFWmonitor *monitor, int event) {
         theia::Dear::MonitorCallback(monitor, event);
-        theia::Hermes::instance().publish<event::MonitorEvent>(Monitor(monitor),
-                                                               static_cast<event::MonitorEventType>(event));
+        monitor_hermes->publish<event::MonitorEvent>(Monitor(monitor), static_cast<event::MonitorEventType>(event));
+
+        // GLFW frees the monitor once this returns, so it must not be replayed to anyone subscribing later
+        if (event == GLFW_DISCONNECTED) monitor_hermes->forget(monitor);
     });
+
+    for (const auto &monitor : get_monitors())
+        hermes.publish<event::MonitorEvent>(monitor, event::MonitorEventType::Connected);
 }
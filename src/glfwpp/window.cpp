@@ -8,30 +8,70 @@
 
 #include <stdexcept>
 
-glfwpp::Window::Window(GLFWwindow *window)
-    : handle_(window) {
+glfwpp::WindowRef::WindowRef(GLFWwindow *handle)
+    : handle_(handle) {}
+
+glfwpp::Window *glfwpp::WindowRef::get() const {
+    return handle_ ? static_cast<Window *>(glfwGetWindowUserPointer(handle_)) : nullptr;
+}
+
+glfwpp::Window &glfwpp::WindowRef::operator*() const { return *get(); }
+
+glfwpp::Window *glfwpp::WindowRef::operator->() const { return get(); }
+
+glfwpp::WindowRef::operator bool() const { return handle_ != nullptr; }
+
+GLFWwindow *glfwpp::WindowRef::handle() const { return handle_; }
+
+glfwpp::Window::Window(GLFWwindow *window, theia::Hermes &hermes)
+    : handle_(window),
+      hermes_(&hermes) {
+    glfwSetWindowUserPointer(handle_, this);
     set_window_callbacks(*this);
     set_input_callbacks(*this);
+
+    // Seed the cache once; the window callbacks keep it current from here on
+    glfwGetWindowSize(handle_, &state_.size.x, &state_.size.y);
+    glfwGetFramebufferSize(handle_, &state_.framebuffer_size.x, &state_.framebuffer_size.y);
+    glfwGetWindowContentScale(handle_, &state_.content_scale.x, &state_.content_scale.y);
+    glfwGetWindowPos(handle_, &state_.position.x, &state_.position.y);
+    state_.focused = glfwGetWindowAttrib(handle_, GLFW_FOCUSED) == GLFW_TRUE;
+    state_.iconified = glfwGetWindowAttrib(handle_, GLFW_ICONIFIED) == GLFW_TRUE;
+    state_.maximized = glfwGetWindowAttrib(handle_, GLFW_MAXIMIZED) == GLFW_TRUE;
+
+    // Prime the sticky events, so receivers know the initial state without asking GLFW for it
+    const auto fb_size = framebuffer_size();
+    hermes_->publish<event::FramebufferSizeEvent>(handle_, fb_size.x, fb_size.y);
+    const auto scale = content_scale();
+    hermes_->publish<event::WindowContentScaleEvent>(handle_, scale.x, scale.y);
+    hermes_->publish<event::WindowFocusEvent>(handle_, focused());
 }
 
 glfwpp::Window::~Window() {
     if (handle_) {
+        hermes_->forget(handle_);
         glfwDestroyWindow(handle_);
     }
 }
 
 glfwpp::Window::Window(Window &&other) noexcept
-    : handle_(other.handle_) {
+    : handle_(other.handle_),
+      user_pointer_(other.user_pointer_),
+      hermes_(other.hermes_),
+      state_(other.state_) {
     other.handle_ = nullptr;
-    set_window_callbacks(*this);
-    set_input_callbacks(*this);
+    other.user_pointer_ = nullptr;
+    if (handle_) glfwSetWindowUserPointer(handle_, this);
 }
 
 glfwpp::Window &glfwpp::Window::operator=(Window &&other) noexcept {
     if (this != &other) {
         std::swap(handle_, other.handle_);
-        set_window_callbacks(*this);
-        set_input_callbacks(*this);
+        std::swap(user_pointer_, other.user_pointer_);
+        std::swap(hermes_, other.hermes_);
+        std::swap(state_, other.state_);
+        if (handle_) glfwSetWindowUserPointer(handle_, this);
+        if (other.handle_) glfwSetWindowUserPointer(other.handle_, &other);
     }
     return *this;
 }
@@ -44,17 +84,13 @@ void glfwpp::Window::set_should_close(bool value) { glfwSetWindowShouldClose(han
 
 void glfwpp::Window::swap_buffers() { glfwSwapBuffers(handle_); }
 
-glm::ivec2 glfwpp::Window::size() const {
-    int width, height;
-    glfwGetWindowSize(handle_, &width, &height);
-    return {width, height};
-}
+glm::ivec2 glfwpp::Window::size() const { return state_.size; }
 
 void glfwpp::Window::set_size(glm::ivec2 size) { glfwSetWindowSize(handle_, size.x, size.y); }
 
-int glfwpp::Window::w() const { return size().x; }
+int glfwpp::Window::w() const { return state_.size.x; }
 
-int glfwpp::Window::h() const { return size().y; }
+int glfwpp::Window::h() const { return state_.size.y; }
 
 glm::ivec4 glfwpp::Window::frame_size() const {
     int left, top, right, bottom;
@@ -62,17 +98,9 @@ glm::ivec4 glfwpp::Window::frame_size() const {
     return {left, top, right, bottom};
 }
 
-glm::ivec2 glfwpp::Window::framebuffer_size() const {
-    int width, height;
-    glfwGetFramebufferSize(handle_, &width, &height);
-    return {width, height};
-}
+glm::ivec2 glfwpp::Window::framebuffer_size() const { return state_.framebuffer_size; }
 
-glm::vec2 glfwpp::Window::content_scale() const {
-    float x_scale, y_scale;
-    glfwGetWindowContentScale(handle_, &x_scale, &y_scale);
-    return {x_scale, y_scale};
-}
+glm::vec2 glfwpp::Window::content_scale() const { return state_.content_scale; }
 
 void glfwpp::Window::set_size_limits(glm::ivec2 min_limits, glm::ivec2 max_limits) {
     glfwSetWindowSizeLimits(handle_, min_limits.x, min_limits.y, max_limits.x, max_limits.y);
@@ -80,17 +108,13 @@ void glfwpp::Window::set_size_limits(glm::ivec2 min_limits, glm::ivec2 max_limit
 
 void glfwpp::Window::set_aspect_ratio(int numer, int denom) { glfwSetWindowAspectRatio(handle_, numer, denom); }
 
-glm::ivec2 glfwpp::Window::position() const {
-    int x, y;
-    glfwGetWindowPos(handle_, &x, &y);
-    return {x, y};
-}
+glm::ivec2 glfwpp::Window::position() const { return state_.position; }
 
 void glfwpp::Window::set_position(glm::ivec2 pos) { glfwSetWindowPos(handle_, pos.x, pos.y); }
 
-int glfwpp::Window::x() const { return position().x; }
+int glfwpp::Window::x() const { return state_.position.x; }
 
-int glfwpp::Window::y() const { return position().y; }
+int glfwpp::Window::y() const { return state_.position.y; }
 
 const char *glfwpp::Window::title() const { return glfwGetWindowTitle(handle_); }
 
@@ -138,11 +162,11 @@ float glfwpp::Window::opacity() const { return glfwGetWindowOpacity(handle_); }
 
 void glfwpp::Window::set_opacity(float opacity) { glfwSetWindowOpacity(handle_, opacity); }
 
-bool glfwpp::Window::focused() const { return glfwGetWindowAttrib(handle_, GLFW_FOCUSED) == GLFW_TRUE; }
+bool glfwpp::Window::focused() const { return state_.focused; }
 
-bool glfwpp::Window::iconified() const { return glfwGetWindowAttrib(handle_, GLFW_ICONIFIED) == GLFW_TRUE; }
+bool glfwpp::Window::iconified() const { return state_.iconified; }
 
-bool glfwpp::Window::maximized() const { return glfwGetWindowAttrib(handle_, GLFW_MAXIMIZED) == GLFW_TRUE; }
+bool glfwpp::Window::maximized() const { return state_.maximized; }
 
 bool glfwpp::Window::hovered() const { return glfwGetWindowAttrib(handle_, GLFW_HOVERED) == GLFW_TRUE; }
 
@@ -272,12 +296,16 @@ void glfwpp::Window::set_scroll_callback(GLFWscrollfun callback) { glfwSetScroll
 
 void glfwpp::Window::set_drop_callback(GLFWdropfun callback) { glfwSetDropCallback(handle_, callback); }
 
-void *glfwpp::Window::user_pointer() const { return glfwGetWindowUserPointer(handle_); }
+void *glfwpp::Window::user_pointer() const { return user_pointer_; }
 
-void glfwpp::Window::set_user_pointer(void *ptr) { glfwSetWindowUserPointer(handle_, ptr); }
+void glfwpp::Window::set_user_pointer(void *ptr) { user_pointer_ = ptr; }
+
+theia::Hermes &glfwpp::Window::hermes() const { return *hermes_; }
 
 GLFWwindow *glfwpp::Window::handle() const { return handle_; }
 
+glfwpp::WindowRef glfwpp::Window::ref() const { return WindowRef(handle_); }
+
 glfwpp::WindowBuilder::WindowBuilder() = default;
 
 glfwpp::WindowBuilder &glfwpp::WindowBuilder::size(glm::ivec2 size) {
@@ -507,6 +535,11 @@ glfwpp::WindowBuilder &glfwpp::WindowBuilder::wayland_app_id(const std::string &
     return *this;
 }
 
+glfwpp::WindowBuilder &glfwpp::WindowBuilder::hermes(theia::Hermes &hermes) {
+    hermes_ = &hermes;
+    return *this;
+}
+
 std::unique_ptr<glfwpp::Window> glfwpp::WindowBuilder::build() const {
     glfwDefaultWindowHints();
 
@@ -533,42 +566,57 @@ std::unique_ptr<glfwpp::Window> glfwpp::WindowBuilder::build() const {
     THEIA_LOG_DEBUG("OpenGL Renderer: {}", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
     THEIA_LOG_DEBUG("OpenGL Vendor: {}", reinterpret_cast<const char *>(glGetString(GL_VENDOR)));
 
-    return std::make_unique<Window>(window);
+    return std::make_unique<Window>(window, hermes_ ? *hermes_ : theia::Hermes::instance());
 }
 
 void glfwpp::set_window_callbacks(Window &window) {
     window.set_close_callback(
-        [](GLFWwindow *window_) { theia::Hermes::instance().publish<event::WindowCloseEvent>(Window(window_)); });
+        [](GLFWwindow *window_) { WindowRef(window_)->hermes().publish<event::WindowCloseEvent>(window_); });
 
+    // The cache is updated before publishing, so receivers already see the new state through the getters
     window.set_size_callback([](GLFWwindow *window_, int width, int height) {
-        theia::Hermes::instance().publish<event::WindowSizeEvent>(Window(window_), width, height);
+        const auto owner = WindowRef(window_);
+        owner->state_.size = {width, height};
+        owner->hermes().publish<event::WindowSizeEvent>(window_, width, height);
     });
 
     window.set_framebuffer_size_callback([](GLFWwindow *window_, int width, int height) {
-        theia::Hermes::instance().publish<event::FramebufferSizeEvent>(Window(window_), width, height);
+        const auto owner = WindowRef(window_);
+        owner->state_.framebuffer_size = {width, height};
+        owner->hermes().publish<event::FramebufferSizeEvent>(window_, width, height);
     });
 
     window.set_content_scale_callback([](GLFWwindow *window_, float xscale, float yscale) {
-        theia::Hermes::instance().publish<event::WindowContentScaleEvent>(Window(window_), xscale, yscale);
+        const auto owner = WindowRef(window_);
+        owner->state_.content_scale = {xscale, yscale};
+        owner->hermes().publish<event::WindowContentScaleEvent>(window_, xscale, yscale);
     });
 
     window.set_pos_callback([](GLFWwindow *window_, int xpos, int ypos) {
-        theia::Hermes::instance().publish<event::WindowPosEvent>(Window(window_), xpos, ypos);
+        const auto owner = WindowRef(window_);
+        owner->state_.position = {xpos, ypos};
+        owner->hermes().publish<event::WindowPosEvent>(window_, xpos, ypos);
     });
 
     window.set_iconify_callback([](GLFWwindow *window_, int iconified) {
-        theia::Hermes::instance().publish<event::WindowIconifyEvent>(Window(window_), iconified == GLFW_TRUE);
+        const auto owner = WindowRef(window_);
+        owner->state_.iconified = iconified == GLFW_TRUE;
+        owner->hermes().publish<event::WindowIconifyEvent>(window_, iconified == GLFW_TRUE);
     });
 
     window.set_maximize_callback([](GLFWwindow *window_, int maximized) {
-        theia::Hermes::instance().publish<event::WindowMaximizeEvent>(Window(window_), maximized == GLFW_TRUE);
+        const auto owner = WindowRef(window_);
+        owner->state_.maximized = maximized == GLFW_TRUE;
+        owner->hermes().publish<event::WindowMaximizeEvent>(window_, maximized == GLFW_TRUE);
     });
 
     window.set_focus_callback([](GLFWwindow *window_, int focused) {
         theia::Dear::WindowFocusCallback(window_, focused);
-        theia::Hermes::instance().publish<event::WindowFocusEvent>(Window(window_), focused == GLFW_TRUE);
+        const auto owner = WindowRef(window_);
+        owner->state_.focused = focused == GLFW_TRUE;
+        owner->hermes().publish<event::WindowFocusEvent>(window_, focused == GLFW_TRUE);
     });
 
     window.set_refresh_callback(
-        [](GLFWwindow *window_) { theia::Hermes::instance().publish<event::WindowRefreshEvent>(Window(window_)); });
+        [](GLFWwindow *window_) { WindowRef(window_)->hermes().publish<event::WindowRefreshEvent>(window_); });
 }
@@ -1,12 +1,73 @@
 #include "theia/overlay.hpp"
 #include "theia/dear.hpp"
 
-void theia::draw_overlay() {
+#include <algorithm>
+#include <array>
+
+#if defined(THEIA_HERMES_STATS)
+static void draw_hermes_stats(theia::Hermes &hermes) {
+    const auto types = theia::Hermes::event_types();
+
+    if (ImGui::Button("reset")) hermes.reset_stats();
+    ImGui::SameLine();
+    theia::Dear::TextDisabled("plain receivers only; batch, async and category receivers aren't timed");
+
+    constexpr auto flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit;
+    theia::Dear::Table("hermes_stats", 5, flags) && [&] {
+        ImGui::TableSetupColumn("event / id");
+        ImGui::TableSetupColumn("count");
+        ImGui::TableSetupColumn("avg us");
+        ImGui::TableSetupColumn("max us");
+        ImGui::TableSetupColumn("latency");
+        ImGui::TableHeadersRow();
+
+        for (const auto &[index, published, handlers] : hermes.stats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            theia::Dear::TextUnformatted(types[index].name);
+            ImGui::TableNextColumn();
+            theia::Dear::Text("{}", published);
+
+            for (const auto &[id, stats] : handlers) {
+                const auto to_us = [](auto ns) { return static_cast<double>(ns.count()) / 1000.0; };
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                theia::Dear::Text("  {}", id);
+                ImGui::TableNextColumn();
+                theia::Dear::Text("{}", stats.calls);
+                ImGui::TableNextColumn();
+                theia::Dear::Text("{:.2f}", stats.calls ? to_us(stats.total) / static_cast<double>(stats.calls) : 0.0);
+                ImGui::TableNextColumn();
+                theia::Dear::Text("{:.2f}", to_us(stats.max));
+                ImGui::TableNextColumn();
+
+                std::array<float, theia::HandlerStats::BUCKETS> buckets{};
+                std::ranges::transform(stats.histogram, buckets.begin(), [](auto n) { return static_cast<float>(n); });
+                ImGui::PushID(static_cast<int>(index));
+                ImGui::PushID(static_cast<int>(id));
+                ImGui::PlotHistogram(
+                    "##latency", buckets.data(), static_cast<int>(buckets.size()), 0, nullptr, 0.0f, FLT_MAX, {96, 16});
+                ImGui::PopID();
+                ImGui::PopID();
+            }
+        }
+    };
+}
+#endif
+
+void theia::draw_overlay(Hermes &hermes) {
     ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
     Dear::Begin("##FPS", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize) &&
         [] { Dear::Text("{:.2f} fps", ImGui::GetIO().Framerate); };
 
     ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x, 0), ImGuiCond_Always, ImVec2(1, 0));
-    Dear::Begin("##Overlay", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize) &&
-        [] { Dear::TabBar("tabs") && [] { Hermes::instance().publish<OverlayTabEvent>(); }; };
+    Dear::Begin("##Overlay", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize) && [&] {
+        Dear::TabBar("tabs") && [&] {
+            hermes.publish<OverlayTabEvent>();
+#if defined(THEIA_HERMES_STATS)
+            Dear::TabItem("Hermes") && [&] { draw_hermes_stats(hermes); };
+#endif
+        };
+    };
 }
@@ -0,0 +1,26 @@
+#include "theia/shm_sink.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+theia::ShmSink::ShmSink(const std::string &name, const std::size_t capacity, Hermes &hermes)
+    : hermes_(hermes),
+      ring_(name, capacity),
+      start_(std::chrono::steady_clock::now()) {
+    tap_ = hermes_.add_tap([this](const std::uint32_t id, const std::span<const std::byte> payload) {
+        const auto it = std::ranges::find(ids_, id);
+        if (it == ids_.end()) return;
+        ring_.write(static_cast<std::size_t>(it - ids_.begin()), std::chrono::steady_clock::now() - start_, payload);
+    });
+}
+
+theia::ShmSink::~ShmSink() { hermes_.remove_tap(tap_); }
+
+void theia::ShmSink::watch_(const std::uint32_t id, const std::uint32_t size, const std::string_view name) {
+    if (std::ranges::find(ids_, id) != ids_.end()) return;
+
+    if (ring_.add_type(id, size, name) == shm::MAX_TYPES) {
+        throw std::runtime_error("ShmSink can watch at most " + std::to_string(shm::MAX_TYPES) + " event types");
+    }
+    ids_.push_back(id);
+}
@@ -0,0 +1,180 @@
+#include "theia/trace.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+constexpr std::array<char, 4> MAGIC{'H', 'R', 'M', 'T'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t FILE_HEADER_SIZE = 8;
+
+struct RecordHeader {
+    std::uint32_t id;
+    std::uint32_t size;
+    std::int64_t timestamp_ns;
+};
+
+constexpr std::size_t INITIAL_CAPACITY = 1 << 20;
+
+constexpr std::size_t padded(const std::size_t size) { return (size + 7) & ~std::size_t{7}; }
+} // namespace
+
+theia::TraceWriter::TraceWriter(const std::filesystem::path &path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open trace file '" + path.string() + "'");
+    }
+
+    // The destructor doesn't run if the constructor throws, so the descriptor has to be closed here
+    try {
+        map_(INITIAL_CAPACITY);
+    } catch (...) {
+        ::close(fd_);
+        throw;
+    }
+
+    std::memcpy(data_, MAGIC.data(), MAGIC.size());
+    std::memcpy(data_ + MAGIC.size(), &VERSION, sizeof(VERSION));
+    size_ = FILE_HEADER_SIZE;
+}
+
+theia::TraceWriter::~TraceWriter() {
+    if (data_) ::munmap(data_, capacity_);
+    if (fd_ >= 0) {
+        // Drop the unused tail of the last growth step
+        [[maybe_unused]] const auto result = ::ftruncate(fd_, static_cast<off_t>(size_));
+        ::close(fd_);
+    }
+}
+
+void theia::TraceWriter::append(const std::uint32_t id,
+                                const std::chrono::nanoseconds timestamp,
+                                const std::span<const std::byte> payload) {
+    const auto record_size = sizeof(RecordHeader) + padded(payload.size());
+    if (size_ + record_size > capacity_) map_(std::max(capacity_ * 2, size_ + record_size));
+
+    const auto header = RecordHeader{id, static_cast<std::uint32_t>(payload.size()), timestamp.count()};
+    std::memcpy(data_ + size_, &header, sizeof(header));
+    std::memcpy(data_ + size_ + sizeof(header), payload.data(), payload.size());
+    size_ += record_size;
+}
+
+std::size_t theia::TraceWriter::size() const { return size_; }
+
+void theia::TraceWriter::map_(const std::size_t capacity) {
+    if (data_) ::munmap(data_, capacity_);
+    data_ = nullptr;
+
+    if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+        throw std::runtime_error("Failed to grow trace file");
+    }
+
+    void *mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map trace file");
+    }
+
+    data_ = static_cast<std::byte *>(mapping);
+    capacity_ = capacity;
+}
+
+theia::TraceReader::TraceReader(const std::filesystem::path &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open trace file '" + path.string() + "'");
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < FILE_HEADER_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("Trace file '" + path.string() + "' is truncated");
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map trace file '" + path.string() + "'");
+    }
+    data_ = static_cast<std::byte *>(mapping);
+
+    std::uint32_t version;
+    std::memcpy(&version, data_ + MAGIC.size(), sizeof(version));
+    if (std::memcmp(data_, MAGIC.data(), MAGIC.size()) != 0 || version != VERSION) {
+        ::munmap(data_, size_);
+        throw std::runtime_error("'" + path.string() + "' is not a Hermes trace");
+    }
+
+    rewind();
+}
+
+theia::TraceReader::~TraceReader() {
+    if (data_) ::munmap(data_, size_);
+}
+
+std::optional<theia::TraceRecord> theia::TraceReader::next() {
+    if (offset_ + sizeof(RecordHeader) > size_) return std::nullopt;
+
+    RecordHeader header;
+    std::memcpy(&header, data_ + offset_, sizeof(header));
+    if (offset_ + sizeof(header) + header.size > size_) return std::nullopt;
+
+    const auto record = TraceRecord{header.id,
+                                    std::chrono::nanoseconds(header.timestamp_ns),
+                                    std::span(data_ + offset_ + sizeof(header), header.size)};
+    offset_ += sizeof(header) + padded(header.size);
+    return record;
+}
+
+void theia::TraceReader::rewind() { offset_ = FILE_HEADER_SIZE; }
+
+theia::TraceRecorder::TraceRecorder(const std::filesystem::path &path, Hermes &hermes)
+    : hermes_(hermes),
+      writer_(path),
+      start_(std::chrono::steady_clock::now()) {
+    tap_ = hermes_.add_tap([this](const std::uint32_t id, const std::span<const std::byte> payload) {
+        if (std::ranges::find(ids_, id) == ids_.end()) return;
+        writer_.append(id, std::chrono::steady_clock::now() - start_, payload);
+    });
+}
+
+theia::TraceRecorder::~TraceRecorder() { hermes_.remove_tap(tap_); }
+
+theia::TraceReplay::TraceReplay(const std::filesystem::path &path, ReplaySpeed speed, Hermes &hermes)
+    : hermes_(hermes),
+      reader_(path),
+      speed_(speed) {
+    next_ = reader_.next();
+}
+
+bool theia::TraceReplay::pump() {
+    if (!start_) start_ = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::steady_clock::now() - *start_;
+
+    while (next_) {
+        if (speed_ == ReplaySpeed::Original && next_->timestamp > elapsed) return true;
+        publish_(*next_);
+        next_ = reader_.next();
+    }
+    return false;
+}
+
+bool theia::TraceReplay::finished() const { return !next_; }
+
+void theia::TraceReplay::publish_(const TraceRecord &record) {
+    auto it = types_.find(record.id);
+    if (it == types_.end()) {
+        // Types that aren't linked into this process can't have receivers either, so they are simply skipped
+        const auto info = Hermes::find_event_type(record.id);
+        if (!info || !info->republish) return;
+        it = types_.emplace(record.id, *info).first;
+    }
+    it->second.republish(hermes_, record.payload);
+}
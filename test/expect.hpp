@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdio>
+
+// Shared by the single-behaviour tests: prints one line per check and counts the failures for main() to return
+namespace test {
+inline int failures = 0;
+
+inline void expect(const bool ok, const char *what) {
+    std::printf("%-60s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+inline int result() { return failures == 0 ? 0 : 1; }
+} // namespace test
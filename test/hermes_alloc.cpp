@@ -0,0 +1,113 @@
+// Publishing a glfwpp event with a receiver attached must not touch the heap. Every allocation in the process goes
+// through the counting operator new below, and each event type is published repeatedly once its channel exists.
+//
+// DropEvent is the exception by design: it owns its path list, which the drop callback copies out of GLFW's strings
+// because those are only valid during the callback, so each drop allocates. Only publishing a DropEvent whose list is
+// already built is checked here, and reported as such.
+
+#include "expect.hpp"
+
+#include "glfwpp/input.hpp"
+#include "glfwpp/window.hpp"
+
+#include "theia/hermes.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> allocations{0};
+
+constexpr std::size_t PUBLISHES = 1000;
+
+void report(const std::string &name, const std::size_t allocated, const std::size_t received) {
+    const auto what =
+        name + " (" + std::to_string(allocated) + " allocations, " + std::to_string(received) + " received)";
+    test::expect(allocated == 0 && received == PUBLISHES + 1, what.c_str());
+}
+
+template <typename T, typename... Args>
+void expect_no_allocations(theia::Hermes &hermes, const Args &...args) {
+    std::size_t received = 0;
+    const auto subscription = hermes.subscribe<T>([&](T *) { ++received; });
+
+    // Creates the channel and, for sticky types, the slot holding the latest payload
+    hermes.publish<T>(args...);
+
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < PUBLISHES; ++i)
+        hermes.publish<T>(args...);
+    report(std::string(T::HERMES_NAME), allocations.load(std::memory_order_relaxed) - before, received);
+}
+
+void expect_drop_publish_without_allocations(theia::Hermes &hermes, const glfwpp::WindowRef &window) {
+    using glfwpp::event::DropEvent;
+
+    std::vector<std::vector<std::filesystem::path>> lists(PUBLISHES + 1);
+    for (auto &paths : lists)
+        paths = {"/tmp/a.png", "/tmp/b.png"};
+
+    std::size_t received = 0;
+    const auto subscription = hermes.subscribe<DropEvent>([&](DropEvent *e) { received += e->paths.size() == 2; });
+
+    hermes.publish<DropEvent>(window, std::move(lists[PUBLISHES]));
+
+    const auto before = allocations.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < PUBLISHES; ++i)
+        hermes.publish<DropEvent>(window, std::move(lists[i]));
+    report(std::string(DropEvent::HERMES_NAME) + " publish, path list built by the caller",
+           allocations.load(std::memory_order_relaxed) - before,
+           received);
+}
+} // namespace
+
+void *operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    if (void *p = std::aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main() {
+    using namespace glfwpp::event;
+
+    theia::Hermes hermes;
+    const auto window = glfwpp::WindowRef();
+
+    expect_no_allocations<KeyEvent>(hermes, window, GLFW_KEY_A, 0, GLFW_PRESS, 0);
+    expect_no_allocations<CharEvent>(hermes, window, 97u);
+    expect_no_allocations<CursorPosEvent>(hermes, window, 1.0, 2.0);
+    expect_no_allocations<CursorEnterEvent>(hermes, window, true);
+    expect_no_allocations<MouseButtonEvent>(hermes, window, GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0);
+    expect_no_allocations<ScrollEvent>(hermes, window, 0.0, 1.0);
+    expect_drop_publish_without_allocations(hermes, window);
+    expect_no_allocations<JoystickEvent>(hermes, GLFW_JOYSTICK_1, JoystickEventType::Connected);
+
+    expect_no_allocations<WindowCloseEvent>(hermes, window);
+    expect_no_allocations<WindowSizeEvent>(hermes, window, 800, 600);
+    expect_no_allocations<FramebufferSizeEvent>(hermes, window, 800, 600);
+    expect_no_allocations<WindowContentScaleEvent>(hermes, window, 1.0f, 1.0f);
+    expect_no_allocations<WindowPosEvent>(hermes, window, 10, 20);
+    expect_no_allocations<WindowIconifyEvent>(hermes, window, false);
+    expect_no_allocations<WindowMaximizeEvent>(hermes, window, true);
+    expect_no_allocations<WindowFocusEvent>(hermes, window, true);
+    expect_no_allocations<WindowRefreshEvent>(hermes, window);
+
+    return test::result();
+}
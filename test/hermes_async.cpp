@@ -0,0 +1,102 @@
+// subscribe_async(): receivers run on the given pool with their own copy of the payload, the Completion returned by
+// publish() tracks them, and unsubscribing before a queued receiver starts means it never runs.
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+#include "theia/worker_pool.hpp"
+
+#include <atomic>
+#include <latch>
+#include <string>
+#include <thread>
+
+namespace {
+struct Job {
+    MAKE_HERMES_ID(Job);
+    std::string name;
+};
+
+void runs_on_pool() {
+    theia::WorkerPool pool(2);
+    theia::Hermes hermes;
+    std::atomic<std::thread::id> ran_on{};
+    const auto subscription = hermes.subscribe_async<Job>(
+        [&](const Job &) { ran_on.store(std::this_thread::get_id(), std::memory_order_relaxed); }, pool);
+
+    hermes.publish<Job>("a").wait();
+    const auto thread = ran_on.load(std::memory_order_relaxed);
+    test::expect(thread != std::thread::id() && thread != std::this_thread::get_id(),
+                 "async receivers run on the pool");
+}
+
+void payload_outlives_publish() {
+    theia::WorkerPool pool(1);
+    theia::Hermes hermes;
+    std::latch published(1);
+    std::string seen{};
+    const auto subscription = hermes.subscribe_async<Job>(
+        [&](const Job &job) {
+            published.wait();
+            seen = job.name;
+        },
+        pool);
+
+    auto completion = hermes.publish<Job>(std::string(64, 'x'));
+    const bool pending = !completion.done();
+    published.count_down();
+    completion.wait();
+    test::expect(pending && completion.done() && seen == std::string(64, 'x'),
+                 "the payload stays valid after publish() returns");
+}
+
+void nothing_to_track() {
+    theia::Hermes hermes;
+    int calls = 0;
+    const auto subscription = hermes.subscribe<Job>([&](Job *) { ++calls; });
+
+    const auto completion = hermes.publish<Job>("b");
+    test::expect(calls == 1 && completion.done(), "Completion is done when no async receiver ran");
+}
+
+void unsubscribed_before_start() {
+    theia::WorkerPool pool(1);
+    theia::Hermes hermes;
+    std::latch gate(1);
+    std::atomic<int> calls{0};
+    auto subscription = hermes.subscribe_async<Job>([&](const Job &) { ++calls; }, pool);
+
+    // Holds the only worker, so the receiver is still queued when it is unsubscribed
+    pool.submit([&] { gate.wait(); });
+    const auto completion = hermes.publish<Job>("c");
+    subscription.reset();
+    gate.count_down();
+    completion.wait();
+    test::expect(calls.load() == 0, "a receiver unsubscribed while queued never runs");
+}
+
+void deferred_starts_on_drain() {
+    theia::WorkerPool pool(1);
+    theia::Hermes hermes;
+    hermes.set_delivery<Job>(theia::Delivery::Deferred);
+    std::atomic<int> calls{0};
+    const auto subscription = hermes.subscribe_async<Job>([&](const Job &) { ++calls; }, pool);
+
+    const auto completion = hermes.publish<Job>("d");
+    const bool untracked = completion.done();
+    hermes.drain();
+    while (calls.load() == 0)
+        std::this_thread::yield();
+    test::expect(untracked && calls.load() == 1, "deferred payloads start async receivers on drain()");
+}
+} // namespace
+
+int main() {
+    runs_on_pool();
+    payload_outlives_publish();
+    nothing_to_track();
+    unsubscribed_before_start();
+    deferred_starts_on_drain();
+
+    return test::result();
+}
@@ -0,0 +1,110 @@
+// co_await hermes.next<T>(): waiters resume from inside the matching publish, a destroyed Task stops waiting, and a
+// coroutine that throws when resumed leaves the other waiters parked for the next payload.
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+#include "theia/task.hpp"
+
+#include <optional>
+#include <stdexcept>
+
+namespace {
+struct Tick {
+    MAKE_HERMES_ID(Tick);
+    int value;
+};
+
+theia::Task record(theia::Hermes &hermes, int &out) { out = (co_await hermes.next<Tick>())->value; }
+
+theia::Task record_even(theia::Hermes &hermes, int &out) {
+    out = (co_await hermes.next<Tick>([](const Tick &tick) { return tick.value % 2 == 0; }))->value;
+}
+
+theia::Task count_forever(theia::Hermes &hermes, int &count) {
+    for (;;) {
+        co_await hermes.next<Tick>();
+        ++count;
+    }
+}
+
+theia::Task throw_on_resume(theia::Hermes &hermes) {
+    co_await hermes.next<Tick>();
+    throw std::runtime_error("receiver failed");
+}
+
+void resumes_on_publish() {
+    theia::Hermes hermes;
+    int out = 0;
+    const auto task = record(hermes, out);
+
+    const bool parked = !task.done() && out == 0;
+    hermes.publish<Tick>(7);
+    test::expect(parked && task.done() && out == 7, "waiter resumes with the published payload");
+}
+
+void predicate_filters() {
+    theia::Hermes hermes;
+    int out = 0;
+    const auto task = record_even(hermes, out);
+
+    hermes.publish<Tick>(3);
+    const bool skipped = !task.done() && out == 0;
+    hermes.publish<Tick>(4);
+    test::expect(skipped && task.done() && out == 4, "predicate keeps the waiter parked until it matches");
+}
+
+void waits_again_for_next_payload() {
+    theia::Hermes hermes;
+    int count = 0;
+    const auto task = count_forever(hermes, count);
+
+    hermes.publish<Tick>(1);
+    hermes.publish<Tick>(2);
+    test::expect(count == 2, "a waiter that waits again sees the next payload once");
+}
+
+void destroyed_task_stops_waiting() {
+    theia::Hermes hermes;
+    int out = 0;
+    std::optional<theia::Task> task = record(hermes, out);
+
+    task.reset();
+    hermes.publish<Tick>(5);
+    test::expect(out == 0, "destroying a suspended Task cancels its wait");
+}
+
+void throw_keeps_other_waiters() {
+    theia::Hermes hermes;
+    int before = 0;
+    int after = 0;
+
+    // Waiters are resumed newest first, so the thrower runs between the two recorders
+    const auto first = record(hermes, before);
+    const auto thrower = throw_on_resume(hermes);
+    const auto second = record(hermes, after);
+
+    bool threw = false;
+    try {
+        hermes.publish<Tick>(1);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    test::expect(threw, "an exception from a resumed waiter reaches the publisher");
+
+    const int missed = before + after;
+    hermes.publish<Tick>(2);
+    test::expect(missed == 1 && first.done() && second.done() && before + after == 3,
+                 "waiters after a throwing one get the next payload");
+}
+} // namespace
+
+int main() {
+    resumes_on_publish();
+    predicate_filters();
+    waits_again_for_next_payload();
+    destroyed_task_stops_waiting();
+    throw_keeps_other_waiters();
+
+    return test::result();
+}
@@ -0,0 +1,123 @@
+// Deferred delivery: payloads wait for drain(), and whatever a receiver publishes while drain() runs waits for the next
+// one, whichever order the pending types are visited in.
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+
+#include <span>
+
+namespace {
+struct Ping {
+    MAKE_HERMES_ID(Ping);
+    int value;
+};
+
+struct Pong {
+    MAKE_HERMES_ID(Pong);
+    int value;
+};
+
+struct Tick {
+    MAKE_HERMES_ID(Tick);
+    int value;
+};
+
+void held_until_drain() {
+    theia::Hermes hermes;
+    hermes.set_delivery<Ping>(theia::Delivery::Deferred);
+    int calls = 0;
+    const auto subscription = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+
+    hermes.publish<Ping>(1);
+    const bool held = calls == 0;
+    hermes.drain();
+    test::expect(held && calls == 1, "a deferred payload is delivered by drain()");
+}
+
+// The fast path publish() takes for plain receivers must notice the switch either way
+void switched_after_subscribing() {
+    theia::Hermes hermes;
+    int calls = 0;
+    const auto subscription = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+
+    hermes.set_delivery<Ping>(theia::Delivery::Deferred);
+    hermes.publish<Ping>(1);
+    const bool held = calls == 0;
+    hermes.drain();
+    const bool drained = calls == 1;
+
+    hermes.set_delivery<Ping>(theia::Delivery::Immediate);
+    hermes.publish<Ping>(2);
+    test::expect(held && drained && calls == 2, "switching delivery after subscribing takes effect both ways");
+}
+
+// Pong is already pending when Ping's receiver publishes another one. Which of the two drain() reaches first depends on
+// the order they became pending, so both orders are tried.
+void published_while_draining(const bool pong_first, const char *what) {
+    theia::Hermes hermes;
+    hermes.set_delivery<Ping>(theia::Delivery::Deferred);
+    hermes.set_delivery<Pong>(theia::Delivery::Deferred);
+
+    int pongs = 0;
+    const auto on_ping = hermes.subscribe<Ping>([&](Ping *) { hermes.publish<Pong>(2); });
+    const auto on_pong = hermes.subscribe<Pong>([&](Pong *) { ++pongs; });
+
+    if (pong_first) hermes.publish<Pong>(1);
+    hermes.publish<Ping>(1);
+    if (!pong_first) hermes.publish<Pong>(1);
+
+    hermes.drain();
+    const auto first = pongs;
+    hermes.drain();
+    test::expect(first == 1 && pongs == 2, what);
+}
+
+void batch_published_while_draining() {
+    theia::Hermes hermes;
+    hermes.set_delivery<Ping>(theia::Delivery::Deferred);
+
+    std::size_t pongs = 0;
+    const auto id = hermes.acquire_id();
+    hermes.subscribe<Ping>(id, [&](Ping *) { hermes.publish<Pong>(2); });
+    hermes.subscribe_batch<Pong>(id, [&](std::span<const Pong> events) { pongs += events.size(); });
+
+    hermes.publish<Ping>(1);
+    hermes.publish<Pong>(1);
+    hermes.drain();
+    const auto first = pongs;
+    hermes.drain();
+    hermes.release_id(id);
+    test::expect(first == 1 && pongs == 2, "batched while draining: held for the next drain()");
+}
+
+// Ping's receiver creates Pong's mailbox while drain() is pumping the mailboxes
+void mailbox_created_while_draining() {
+    theia::Hermes hermes;
+    theia::MpscQueue<Pong> *pongs_mailbox = nullptr;
+    int pongs = 0;
+    const auto on_ping = hermes.subscribe<Ping>([&](Ping *) {
+        // The list of mailboxes only has room for Ping's and Tick's, so adding Pong's reallocates it
+        pongs_mailbox = &hermes.mailbox<Pong>();
+        (void)pongs_mailbox->try_emplace(2);
+    });
+    const auto on_pong = hermes.subscribe<Pong>([&](Pong *) { ++pongs; });
+
+    (void)hermes.mailbox<Ping>().try_emplace(1);
+    (void)hermes.mailbox<Tick>();
+    hermes.drain();
+    const auto first = pongs;
+    hermes.drain();
+    test::expect(first == 0 && pongs == 1, "a mailbox created while draining is pumped from the next drain()");
+}
+} // namespace
+
+int main() {
+    held_until_drain();
+    switched_after_subscribing();
+    published_while_draining(false, "published while draining, type not yet drained: held");
+    published_while_draining(true, "published while draining, type already drained: held");
+    batch_published_while_draining();
+    mailbox_created_while_draining();
+    return test::result();
+}
@@ -0,0 +1,67 @@
+// StaticHermes::with(): handlers fixed in the bus type run for every event type they take, in order and before the
+// receivers subscribed at runtime, which keep working alongside them.
+
+#include "expect.hpp"
+
+#include "theia/static_hermes.hpp"
+
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace {
+struct Ping {
+    MAKE_HERMES_ID(Ping);
+    int value;
+};
+
+struct Pong {
+    MAKE_HERMES_ID(Pong);
+};
+
+void handlers_by_type() {
+    std::string order{};
+    auto hermes = theia::StaticHermes<Ping, Pong>::with([&](Ping *e) { order += std::to_string(e->value); },
+                                                        [&](Pong *) { order += 'o'; },
+                                                        [&](auto *) { order += '*'; });
+
+    hermes.publish<Ping>(1);
+    hermes.publish<Pong>();
+    test::expect(order == "1*o*", "fixed handlers run for the types they take, in order");
+}
+
+void alongside_runtime_receivers() {
+    std::string order{};
+    auto hermes = theia::StaticHermes<Ping, Pong>::with([&](Ping *) { order += 'f'; });
+
+    const auto id = hermes.subscribe<Ping>([&](Ping *) { order += 'r'; });
+    hermes.publish<Ping>(0);
+    hermes.unsubscribe<Ping>(id);
+    hermes.publish<Ping>(0);
+    test::expect(order == "frf", "runtime receivers run after the fixed handlers");
+}
+
+void subscribe_from_fixed_handler() {
+    int calls = 0;
+    std::function<theia::StaticHermes<Ping, Pong>::ID()> subscribe{};
+    std::optional<theia::StaticHermes<Ping, Pong>::ID> id{};
+    auto hermes = theia::StaticHermes<Ping, Pong>::with([&](Ping *) {
+        if (!id) id = subscribe();
+    });
+    // The handler can't name the bus's type, so it subscribes through a function bound once the bus exists
+    subscribe = [&] { return hermes.subscribe<Ping>([&](Ping *) { ++calls; }); };
+
+    hermes.publish<Ping>(0);
+    const bool waited = calls == 0;
+    hermes.publish<Ping>(0);
+    test::expect(waited && calls == 1, "a receiver a fixed handler subscribes starts at the next");
+}
+} // namespace
+
+int main() {
+    handlers_by_type();
+    alongside_runtime_receivers();
+    subscribe_from_fixed_handler();
+
+    return test::result();
+}
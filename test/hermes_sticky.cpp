@@ -0,0 +1,164 @@
+// Sticky channels: new subscribers are handed the latest payload per source, forget() drops a source's payload, and
+// replaying on another thread neither holds up the thread that owns the bus nor races with it publishing.
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Size {
+    MAKE_HERMES_ID(Size);
+    HERMES_STICKY
+    int width;
+};
+
+struct Frame {
+    MAKE_HERMES_ID(Frame);
+};
+
+// Stands in for a window or monitor handle
+struct Focus {
+    MAKE_HERMES_ID(Focus);
+    HERMES_STICKY
+    HERMES_SOURCE(source);
+    const void *source;
+    bool focused;
+};
+
+int first_window = 0;
+int second_window = 0;
+
+void replays_latest_per_source() {
+    theia::Hermes hermes;
+    hermes.publish<Focus>(&first_window, true);
+    hermes.publish<Focus>(&second_window, true);
+    hermes.publish<Focus>(&first_window, false);
+
+    std::vector<Focus> seen{};
+    const auto subscription = hermes.subscribe<Focus>([&](Focus *e) { seen.push_back(*e); });
+    test::expect(seen.size() == 2 && seen[0].source == &second_window && seen[1].source == &first_window &&
+                     !seen[1].focused,
+                 "a new subscriber gets the latest payload per source");
+}
+
+void scoped_replay() {
+    theia::Hermes hermes;
+    hermes.publish<Focus>(&first_window, true);
+    hermes.publish<Focus>(&second_window, false);
+
+    std::vector<Focus> seen{};
+    const auto id = hermes.acquire_id();
+    hermes.subscribe<Focus>(id, &second_window, [&](Focus *e) { seen.push_back(*e); });
+    hermes.release_id(id);
+    test::expect(seen.size() == 1 && seen[0].source == &second_window, "a scoped subscriber only gets its source");
+}
+
+void forget_drops_source() {
+    theia::Hermes hermes;
+    hermes.publish<Focus>(&first_window, true);
+    hermes.publish<Focus>(&second_window, true);
+
+    hermes.forget(&first_window);
+    std::vector<Focus> seen{};
+    const auto subscription = hermes.subscribe<Focus>([&](Focus *e) { seen.push_back(*e); });
+    test::expect(seen.size() == 1 && seen[0].source == &second_window && !hermes.latest<Focus>(&first_window) &&
+                     hermes.latest<Focus>()->source == &second_window,
+                 "forget() drops the source from replay and latest()");
+}
+
+// A deferred payload is only remembered once drain() delivers it, so a receiver subscribing in between isn't handed it
+// by the replay and then again by the drain
+void deferred_delivered_once() {
+    theia::Hermes hermes;
+    hermes.set_delivery<Size>(theia::Delivery::Deferred);
+    hermes.publish<Size>(800);
+
+    int calls = 0;
+    const auto subscription = hermes.subscribe<Size>([&](Size *) { ++calls; });
+    const bool held = calls == 0 && !hermes.latest<Size>();
+    hermes.drain();
+
+    int late_calls = 0;
+    const auto late = hermes.subscribe<Size>([&](Size *e) { late_calls += e->width == 800; });
+    test::expect(held && calls == 1 && late_calls == 1 && hermes.latest<Size>()->width == 800,
+                 "a deferred sticky payload reaches a new subscriber once");
+}
+
+// Meant for ThreadSanitizer: the owner keeps publishing without a lock while other threads subscribe and replay. The
+// owner may run those receivers as well, so they only touch atomics that outlive the subscriptions.
+void replay_while_publishing() {
+    constexpr int PUBLISHES = 20000;
+    constexpr std::size_t SUBSCRIBERS = 4;
+
+    theia::Hermes hermes;
+    hermes.publish<Size>(0);
+
+    std::array<std::atomic<int>, SUBSCRIBERS> first{};
+    std::atomic<std::size_t> running{SUBSCRIBERS};
+    std::atomic<bool> valid{true};
+    std::vector<std::thread> subscribers{};
+    for (std::size_t i = 0; i < SUBSCRIBERS; ++i)
+        subscribers.emplace_back([&, i] {
+            for (int round = 0; round < 200; ++round) {
+                first[i].store(-1);
+                const auto subscription = hermes.subscribe<Size>([&first, i](Size *e) {
+                    int none = -1;
+                    first[i].compare_exchange_strong(none, e->width);
+                });
+                if (const auto width = first[i].load(); width < 0 || width > PUBLISHES) valid.store(false);
+            }
+            running.fetch_sub(1);
+        });
+
+    for (int width = 1; width <= PUBLISHES || running.load() != 0; ++width)
+        hermes.publish<Size>(width < PUBLISHES ? width : PUBLISHES);
+    for (auto &subscriber : subscribers)
+        subscriber.join();
+    test::expect(valid.load() && hermes.latest<Size>()->width == PUBLISHES,
+                 "replaying on other threads while the owner publishes");
+}
+
+void replay_waits_on_owner() {
+    theia::Hermes hermes;
+    hermes.publish<Size>(800);
+
+    int frames = 0;
+    const auto subscription = hermes.subscribe<Frame>([&](Frame *) { ++frames; });
+
+    // The replayed receiver waits for the owning thread to get through a publish(), which must not wait for the replay
+    std::atomic<bool> replaying{false};
+    std::atomic<bool> published{false};
+    theia::Subscription late{};
+    std::thread subscriber([&] {
+        late = hermes.subscribe<Size>([&](Size *) {
+            replaying.store(true);
+            replaying.notify_all();
+            published.wait(false);
+        });
+    });
+
+    replaying.wait(false);
+    hermes.publish<Frame>();
+    published.store(true);
+    published.notify_all();
+    subscriber.join();
+    test::expect(frames == 1, "a replay on another thread doesn't block the owner");
+}
+} // namespace
+
+int main() {
+    replays_latest_per_source();
+    scoped_replay();
+    forget_drops_source();
+    deferred_delivered_once();
+    replay_while_publishing();
+    replay_waits_on_owner();
+
+    return test::result();
+}
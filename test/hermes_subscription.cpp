@@ -0,0 +1,164 @@
+// Subscription and SubscriptionGroup: dropping the handle is what unsubscribes, moving it hands that over, and a group
+// takes everything registered under its ID down at once, across types, captures and category listeners.
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace {
+struct Ping {
+    MAKE_HERMES_ID(Ping);
+    HERMES_CATEGORY(1);
+};
+
+struct Pong {
+    MAKE_HERMES_ID(Pong);
+    HERMES_CATEGORY(1);
+};
+
+void drop_unsubscribes() {
+    theia::Hermes hermes;
+    int calls = 0;
+    std::optional<theia::Subscription> subscription = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+
+    hermes.publish<Ping>();
+    subscription.reset();
+    hermes.publish<Ping>();
+    test::expect(calls == 1, "dropping a Subscription unsubscribes");
+}
+
+void reset_releases_id() {
+    theia::Hermes hermes;
+    auto subscription = hermes.subscribe<Ping>([](Ping *) {});
+    const auto id = subscription.id();
+
+    subscription.reset();
+    test::expect(!subscription && hermes.acquire_id() == id, "reset() releases the ID for reuse");
+}
+
+void move_transfers_ownership() {
+    theia::Hermes hermes;
+    int calls = 0;
+    theia::Subscription kept{};
+    {
+        auto moved = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+        kept = std::move(moved);
+    }
+    hermes.publish<Ping>();
+    const bool survived = calls == 1;
+
+    kept = theia::Subscription();
+    hermes.publish<Ping>();
+    test::expect(survived && calls == 1, "a moved-from Subscription leaves the receiver alone");
+}
+
+void drop_during_dispatch() {
+    theia::Hermes hermes;
+    int calls = 0;
+    std::optional<theia::Subscription> later{};
+
+    // Receivers run in subscription order, so the first one drops the second before it is reached
+    const auto first = hermes.subscribe<Ping>([&](Ping *) { later.reset(); });
+    later = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+
+    hermes.publish<Ping>();
+    hermes.publish<Ping>();
+    test::expect(calls == 0, "a Subscription dropped mid-dispatch is skipped at once");
+}
+
+void subscribe_during_dispatch() {
+    theia::Hermes hermes;
+    int calls = 0;
+    std::optional<theia::Subscription> later{};
+    const auto first = hermes.subscribe<Ping>([&](Ping *) {
+        if (!later) later = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+    });
+
+    hermes.publish<Ping>();
+    const bool waited = calls == 0;
+    hermes.publish<Ping>();
+    test::expect(waited && calls == 1, "a Subscription made mid-dispatch starts at the next");
+}
+
+// Dropped receivers stay listed until they outnumber the rest, and their slots are reused; whatever they captured is
+// still destroyed once they are gone
+void churn_releases_receivers() {
+    theia::Hermes hermes;
+    const auto token = std::make_shared<int>(0);
+    int calls = 0;
+    const auto kept = hermes.subscribe<Ping>([&](Ping *) { ++calls; });
+
+    bool delivered = true;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<theia::Subscription> subscriptions{};
+        for (int i = 0; i < 20; ++i)
+            subscriptions.push_back(hermes.subscribe<Ping>([&calls, token](Ping *) { ++calls; }));
+        subscriptions.erase(subscriptions.begin(), subscriptions.begin() + 10);
+
+        calls = 0;
+        hermes.publish<Ping>();
+        delivered = delivered && calls == 11;
+    }
+
+    hermes.publish<Ping>();
+    test::expect(delivered && token.use_count() == 1, "churn reaches the living and frees the dropped");
+}
+
+void group_drops_everything() {
+    theia::Hermes hermes;
+    int calls = 0;
+    std::optional<theia::SubscriptionGroup> group{std::in_place, hermes};
+    group->subscribe<Ping>([&](Ping *) { ++calls; });
+    group->subscribe<Pong>([&](Pong *) { ++calls; });
+    group->subscribe_category(1, [&](theia::EventView) { ++calls; });
+    group->capture<Pong>();
+
+    // A captured Pong only reaches the capturing receiver, not the group's category listener
+    hermes.publish<Ping>();
+    hermes.publish<Pong>();
+    const bool delivered = calls == 3;
+
+    int others = 0;
+    const auto other = hermes.subscribe<Pong>([&](Pong *) { ++others; });
+    hermes.publish<Pong>();
+    const bool captured = others == 0;
+
+    calls = 0;
+    group.reset();
+    hermes.publish<Ping>();
+    hermes.publish<Pong>();
+    test::expect(delivered && captured && calls == 0 && others == 1,
+                 "dropping a group removes receivers, listeners and captures");
+}
+
+void group_move_keeps_subscriptions() {
+    theia::Hermes hermes;
+    int calls = 0;
+    theia::SubscriptionGroup kept(hermes);
+    {
+        theia::SubscriptionGroup moved(hermes);
+        moved.subscribe<Ping>([&](Ping *) { ++calls; });
+        kept = std::move(moved);
+    }
+    hermes.publish<Ping>();
+    test::expect(calls == 1, "a moved-from group leaves the subscriptions alone");
+}
+} // namespace
+
+int main() {
+    drop_unsubscribes();
+    reset_releases_id();
+    move_transfers_ownership();
+    drop_during_dispatch();
+    subscribe_during_dispatch();
+    churn_releases_receivers();
+    group_drops_everything();
+    group_move_keeps_subscriptions();
+
+    return test::result();
+}
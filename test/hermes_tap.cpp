@@ -0,0 +1,77 @@
+// Taps that add or remove taps, themselves included, while a payload is being tapped
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace {
+struct Ping {
+    MAKE_HERMES_ID(Ping);
+    int value;
+};
+
+void removes_itself() {
+    theia::Hermes hermes;
+    int calls = 0;
+    theia::Hermes::TapID self{};
+    self = hermes.add_tap([&](std::uint32_t, std::span<const std::byte>) {
+        ++calls;
+        hermes.remove_tap(self);
+    });
+
+    hermes.publish<Ping>(1);
+    hermes.publish<Ping>(2);
+    test::expect(calls == 1, "a tap that removes itself is called once");
+}
+
+void removes_a_later_tap() {
+    theia::Hermes hermes;
+    int later_calls = 0;
+    std::optional<theia::Hermes::TapID> later{};
+    hermes.add_tap([&](std::uint32_t, std::span<const std::byte>) {
+        if (later) hermes.remove_tap(*later);
+    });
+    later = hermes.add_tap([&](std::uint32_t, std::span<const std::byte>) { ++later_calls; });
+
+    hermes.publish<Ping>(1);
+    test::expect(later_calls == 0, "a tap removed by an earlier one is skipped for the payload being tapped");
+}
+
+void adds_taps() {
+    theia::Hermes hermes;
+    int added_calls = 0;
+    hermes.add_tap([&](std::uint32_t, std::span<const std::byte>) {
+        // Enough to make a vector reallocate under the tap that is running
+        for (int i = 0; i < 64; ++i)
+            hermes.add_tap([&](std::uint32_t, std::span<const std::byte>) { ++added_calls; });
+    });
+
+    hermes.publish<Ping>(1);
+    const auto first = added_calls;
+    hermes.publish<Ping>(2);
+    test::expect(first == 0 && added_calls == 64, "taps added while tapping start with the next payload");
+}
+
+void adds_from_a_receiver() {
+    theia::Hermes hermes;
+    int calls = 0;
+    const auto subscription = hermes.subscribe<Ping>([&](Ping *) {
+        hermes.add_tap([&](std::uint32_t, std::span<const std::byte>) { ++calls; });
+    });
+
+    hermes.publish<Ping>(1);
+    test::expect(calls == 0, "a tap added by a receiver misses the payload that receiver is handling");
+}
+} // namespace
+
+int main() {
+    removes_itself();
+    removes_a_later_tap();
+    adds_taps();
+    adds_from_a_receiver();
+    return test::result();
+}
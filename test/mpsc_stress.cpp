@@ -0,0 +1,162 @@
+// Many producers posting into an MpscQueue, and into Hermes mailboxes drained on the owning thread. Checks that nothing
+// is lost or duplicated, that each producer's payloads arrive in the order it posted them, and that every payload is
+// destroyed exactly once. Meant to be run under ThreadSanitizer as well (configure with THEIA_TEST_TSAN=ON).
+
+#include "expect.hpp"
+
+#include "theia/hermes.hpp"
+#include "theia/mpsc_queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr std::size_t PER_PRODUCER = 5000;
+
+void expect(const bool ok, const char *what, const std::size_t producers) {
+    const auto line = std::string(what) + ", " + std::to_string(producers) + " producers";
+    test::expect(ok, line.c_str());
+}
+
+std::atomic<std::ptrdiff_t> alive{0};
+
+// Counts live instances, so a payload dropped without being destroyed, or destroyed twice, shows up as a leftover
+struct Tracked {
+    std::size_t producer;
+    std::size_t seq;
+
+    Tracked(const std::size_t producer, const std::size_t seq)
+        : producer(producer),
+          seq(seq) {
+        alive.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Tracked(const Tracked &other)
+        : Tracked(other.producer, other.seq) {}
+
+    Tracked(Tracked &&other) noexcept
+        : Tracked(other.producer, other.seq) {}
+
+    Tracked &operator=(const Tracked &other) = default;
+    Tracked &operator=(Tracked &&other) noexcept = default;
+
+    ~Tracked() { alive.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+struct Posted : Tracked {
+    MAKE_HERMES_ID(theia::test::Posted);
+    using Tracked::Tracked;
+};
+
+// Checks per-producer ordering of whatever the consumer sees
+class Sequencer {
+public:
+    explicit Sequencer(const std::size_t producers)
+        : next_(producers, 0) {}
+
+    void see(const Tracked &payload) {
+        if (payload.producer < next_.size() && payload.seq == next_[payload.producer]) {
+            ++next_[payload.producer];
+        } else {
+            in_order_ = false;
+        }
+        ++seen_;
+    }
+
+    [[nodiscard]] bool complete() const {
+        if (!in_order_ || seen_ != next_.size() * PER_PRODUCER) return false;
+        for (const auto next : next_)
+            if (next != PER_PRODUCER) return false;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t seen() const { return seen_; }
+
+private:
+    std::vector<std::size_t> next_;
+    std::size_t seen_{0};
+    bool in_order_{true};
+};
+
+// Starts `producers` threads that each post PER_PRODUCER payloads through `post`, retrying while it reports the
+// queue full, and runs `consume` on this thread until they are done and once more after that
+template <typename Post, typename Consume>
+void run(const std::size_t producers, Post &&post, Consume &&consume) {
+    std::atomic<std::size_t> running{producers};
+    std::vector<std::thread> threads{};
+    threads.reserve(producers);
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (std::size_t seq = 0; seq < PER_PRODUCER; ++seq)
+                while (!post(p, seq))
+                    std::this_thread::yield();
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    while (running.load(std::memory_order_acquire) > 0)
+        consume();
+    for (auto &thread : threads)
+        thread.join();
+    consume();
+}
+
+void queue_order(const std::size_t producers) {
+    Sequencer sequencer(producers);
+    {
+        // Small, so producers keep finding it full and racing for the same cells
+        theia::MpscQueue<Tracked> queue(64);
+        run(
+            producers,
+            [&](const std::size_t p, const std::size_t seq) { return queue.try_emplace(p, seq); },
+            [&] { queue.consume([&](Tracked &&payload) { sequencer.see(payload); }); });
+    }
+    expect(sequencer.complete(), "MpscQueue delivers everything in order", producers);
+}
+
+void queue_teardown(const std::size_t producers) {
+    // Whatever is still queued when the queue goes away is destroyed with it
+    {
+        theia::MpscQueue<Tracked> queue(producers * PER_PRODUCER);
+        run(producers, [&](const std::size_t p, const std::size_t seq) { return queue.try_emplace(p, seq); }, [] {});
+    }
+    expect(alive.load() == 0, "MpscQueue destroys what it still holds", producers);
+}
+
+void mailbox_order(const std::size_t producers, const theia::Delivery delivery) {
+    Sequencer sequencer(producers);
+    std::size_t batched = 0;
+    {
+        theia::Hermes hermes;
+        hermes.set_delivery<Posted>(delivery);
+        auto &mailbox = hermes.mailbox<Posted>(256);
+
+        const auto subscription = hermes.subscribe<Posted>([&](Posted *payload) { sequencer.see(*payload); });
+        const auto id = hermes.acquire_id();
+        hermes.subscribe_batch<Posted>(id, [&](const std::span<const Posted> payloads) { batched += payloads.size(); });
+
+        run(
+            producers,
+            [&](const std::size_t p, const std::size_t seq) { return mailbox.try_emplace(p, seq); },
+            [&] { hermes.drain(); });
+        hermes.release_id(id);
+    }
+
+    const auto *what = delivery == theia::Delivery::Immediate ? "Hermes mailbox, immediate delivery"
+                                                               : "Hermes mailbox, deferred delivery";
+    expect(sequencer.complete() && batched == sequencer.seen() && alive.load() == 0, what, producers);
+}
+} // namespace
+
+int main() {
+    for (const std::size_t producers : {1, 4, 16}) {
+        queue_order(producers);
+        queue_teardown(producers);
+        mailbox_order(producers, theia::Delivery::Immediate);
+        mailbox_order(producers, theia::Delivery::Deferred);
+    }
+    return test::result();
+}
@@ -0,0 +1,98 @@
+// Tails the shared memory ring written by theia::ShmSink and prints per-type event rates.
+//   theia_hermes_inspect <name> [--interval <ms>] [--payloads]
+
+#include "theia/shm_ring.hpp"
+
+#include <charconv>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+static void print_payload(const theia::shm::RecordHeader &record, const std::span<const std::byte> payload) {
+    std::printf("  %08" PRIx32 " @ %.6fs:", record.id, static_cast<double>(record.timestamp_ns) / 1e9);
+    for (std::size_t i = 0; i < payload.size() && i < 32; ++i)
+        std::printf(" %02x", static_cast<unsigned>(payload[i]));
+    std::fputs(payload.size() > 32 ? " ...\n" : "\n", stdout);
+}
+
+static int usage(const char *program) {
+    std::fprintf(stderr, "usage: %s <name> [--interval <ms>] [--payloads]\n", program);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) return usage(argv[0]);
+
+    const std::string name = argv[1];
+    auto interval = std::chrono::milliseconds(1000);
+    bool payloads = false;
+    for (int i = 2; i < argc; ++i) {
+        const auto arg = std::string_view(argv[i]);
+        if (arg == "--interval" && i + 1 < argc) {
+            const auto value = std::string_view(argv[++i]);
+            int ms = 0;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), ms);
+            if (error != std::errc{} || end != value.data() + value.size() || ms <= 0) return usage(argv[0]);
+            interval = std::chrono::milliseconds(ms);
+        } else if (arg == "--payloads") {
+            payloads = true;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    try {
+        theia::shm::RingReader reader(name);
+
+        // Rates come from the writer's counters, which stay exact even when the ring laps us
+        std::vector<std::uint64_t> previous{};
+        for (const auto &type : reader.types())
+            previous.push_back(type.count.load(std::memory_order_relaxed));
+        auto last = std::chrono::steady_clock::now();
+        std::uint64_t lapped = 0;
+
+        for (;;) {
+            std::this_thread::sleep_for(interval);
+
+            std::unordered_map<std::uint32_t, std::uint64_t> seen{};
+            const auto complete = reader.poll([&](const auto &record, const auto payload) {
+                ++seen[record.id];
+                if (payloads) print_payload(record, payload);
+            });
+            if (!complete) ++lapped;
+
+            const auto now = std::chrono::steady_clock::now();
+            const auto seconds = std::chrono::duration<double>(now - last).count();
+            last = now;
+
+            const auto types = reader.types();
+            previous.resize(types.size(), 0);
+
+            std::printf("%-48s %10s %14s %10s %10s\n", "event", "id", "total", "per sec", "in ring");
+            for (std::size_t i = 0; i < types.size(); ++i) {
+                const auto &type = types[i];
+                const auto count = type.count.load(std::memory_order_relaxed);
+                std::printf("%-48s   %08" PRIx32 " %14" PRIu64 " %10.1f %10" PRIu64 "\n",
+                            type.name,
+                            type.id,
+                            count,
+                            static_cast<double>(count - previous[i]) / seconds,
+                            seen[type.id]);
+                previous[i] = count;
+            }
+
+            const auto oversized = reader.header().oversized.load(std::memory_order_relaxed);
+            std::printf("lapped %" PRIu64 " times, %" PRIu64 " oversized records dropped\n\n", lapped, oversized);
+            std::fflush(stdout);
+        }
+    } catch (const std::exception &e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}